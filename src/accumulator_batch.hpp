@@ -0,0 +1,142 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "fp2_lanes.hpp"
+#include "relaxed_folding.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace crypto {
+
+// Many independent relaxed accumulators (one per stream), structure of arrays
+// Accumulator i is (j_start[i], j_end[i], u[i]). fold() advances every lane
+// by its own fresh witness and challenge, with exactly the arithmetic of
+// RelaxedIsogenyFolder::fold(phi, ...), so lane i ends bit-identical to
+// folding accumulator i alone. The linear combinations run L lanes at a time
+// through Fp2Lanes; the 3n Phi evaluations of a round go to one
+// BivariatePoly::eval_batch call.
+// L = 1 (or QHALO_FIELD_LANES = 1) is the scalar path; lanes past the last
+// full group of L always take it.
+template <typename Config, size_t L = QHALO_FIELD_LANES>
+class AccumulatorBatch {
+  using Fp2T = Fp2<Config>;
+  using Lanes = Fp2Lanes<Config, L>;
+  using Folder = RelaxedIsogenyFolder<Config>;
+
+public:
+  using Witness = typename Folder::RelaxedWitness;
+  static constexpr size_t LANES = L;
+
+  std::vector<Fp2T> j_start;
+  std::vector<Fp2T> j_end;
+  std::vector<Fp2T> u;
+
+  AccumulatorBatch() {}
+  explicit AccumulatorBatch(size_t n)
+      : j_start(n, Fp2T::zero()), j_end(n, Fp2T::zero()), u(n, Fp2T::zero()) {}
+
+  explicit AccumulatorBatch(const std::vector<Witness> &ws)
+      : AccumulatorBatch(ws.size()) {
+    for (size_t i = 0; i < ws.size(); ++i)
+      set(i, ws[i]);
+  }
+
+  size_t size() const { return u.size(); }
+
+  Witness get(size_t i) const { return Witness{j_start[i], j_end[i], u[i]}; }
+
+  void set(size_t i, const Witness &w) {
+    j_start[i] = w.j_start;
+    j_end[i] = w.j_end;
+    u[i] = w.u;
+  }
+
+  // acc_i <- fold(acc_i, fresh_i, rs[i]) for every lane
+  bool fold(const BivariatePoly<Fp2T> &phi, const AccumulatorBatch &fresh,
+            const std::vector<Fp2T> &rs) {
+    const size_t n = size();
+    if (fresh.size() != n || rs.size() != n) {
+      std::cerr << "AccumulatorBatch: fold of " << n << " lanes with "
+                << fresh.size() << " witnesses and " << rs.size()
+                << " challenges" << std::endl;
+      return false;
+    }
+
+    // Evaluation points: [0, n) new accumulators, [n, 2n) old ones,
+    // [2n, 3n) fresh witnesses
+    xs.resize(3 * n);
+    ys.resize(3 * n);
+    vals.resize(3 * n);
+    Fp2T *xn = xs.data(), *yn = ys.data();
+    std::copy(j_start.begin(), j_start.end(), xs.begin() + n);
+    std::copy(j_end.begin(), j_end.end(), ys.begin() + n);
+    std::copy(fresh.j_start.begin(), fresh.j_start.end(), xs.begin() + 2 * n);
+    std::copy(fresh.j_end.begin(), fresh.j_end.end(), ys.begin() + 2 * n);
+
+    // j_new = j + r j_fresh
+    const Fp2T *r = rs.data();
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+      Fp2T t[L];
+      Lanes::mul(t, r + i, fresh.j_start.data() + i);
+      Lanes::add(xn + i, j_start.data() + i, t);
+      Lanes::mul(t, r + i, fresh.j_end.data() + i);
+      Lanes::add(yn + i, j_end.data() + i, t);
+    }
+    for (; i < n; ++i) {
+      xn[i] = Fp2T::add(j_start[i], Fp2T::mul(r[i], fresh.j_start[i]));
+      yn[i] = Fp2T::add(j_end[i], Fp2T::mul(r[i], fresh.j_end[i]));
+    }
+
+    phi.eval_batch(xs.data(), ys.data(), vals.data(), 3 * n);
+
+    // E = Phi(new) - (Phi(old) + r Phi(fresh)), u_new = (u + r u_fresh) + E
+    const Fp2T *v_new = vals.data(), *v_old = v_new + n, *v_fresh = v_old + n;
+    for (i = 0; i + L <= n; i += L) {
+      Fp2T e[L], t[L];
+      Lanes::mul(t, r + i, v_fresh + i);
+      Lanes::add(t, v_old + i, t);
+      Lanes::sub(e, v_new + i, t);
+      Lanes::mul(t, r + i, fresh.u.data() + i);
+      Lanes::add(t, u.data() + i, t);
+      Lanes::add(u.data() + i, t, e);
+    }
+    for (; i < n; ++i) {
+      Fp2T e = Fp2T::sub(v_new[i],
+                         Fp2T::add(v_old[i], Fp2T::mul(r[i], v_fresh[i])));
+      u[i] = Fp2T::add(Fp2T::add(u[i], Fp2T::mul(r[i], fresh.u[i])), e);
+    }
+
+    std::copy(xs.begin(), xs.begin() + n, j_start.begin());
+    std::copy(ys.begin(), ys.begin() + n, j_end.begin());
+    return true;
+  }
+
+  // Phi(j_start_i, j_end_i) = u_i for every lane. ok, if given, receives one
+  // flag per lane; returns true when all lanes pass.
+  bool verify(const BivariatePoly<Fp2T> &phi,
+              std::vector<uint8_t> *ok = nullptr) const {
+    const size_t n = size();
+    vals.resize(n);
+    phi.eval_batch(j_start.data(), j_end.data(), vals.data(), n);
+    if (ok)
+      ok->assign(n, 0);
+    bool all = true;
+    for (size_t i = 0; i < n; ++i) {
+      bool lane = Fp2T::equal(vals[i], u[i]);
+      all = all && lane;
+      if (ok)
+        (*ok)[i] = lane;
+    }
+    return all;
+  }
+
+private:
+  // Scratch reused across rounds
+  mutable std::vector<Fp2T> xs, ys, vals;
+};
+
+} // namespace crypto
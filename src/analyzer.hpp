@@ -1,6 +1,7 @@
 #pragma once
 
 #include "modpoly.hpp"
+#include "small_poly.hpp"
 #include <iostream>
 #include <vector>
 
@@ -13,27 +14,15 @@ template <typename Config> class Phi2Analyzer {
 
 public:
   // Evaluate Phi(X, Y) at (x, y)
-  // coeffs are P_i(X) such that Phi(X, Y) = sum P_i(X) * Y^i
-  static Fp2T eval_phi(const std::vector<Poly> &coeffs, const Fp2T &x,
-                       const Fp2T &y) {
+  // coeffs are P_i(X) such that Phi(X, Y) = sum P_i(X) * Y^i. Rows may be
+  // Polynomial or SmallPoly (anything with eval); Horner in both variables,
+  // so no power of x is recomputed per row and nothing is allocated.
+  template <typename Rows>
+  static Fp2T eval_phi(const Rows &coeffs, const Fp2T &x, const Fp2T &y) {
     Fp2T res = Fp2T::zero();
-    Fp2T y_pow = Fp2T::mont_one();
-
-    for (const auto &px : coeffs) {
-      // Eval px at x
-      Fp2T x_val = Fp2T::zero();
-      Fp2T x_p = Fp2T::mont_one();
-      for (const auto &c : px.coeffs) {
-        Fp2T term = Fp2T::mul(c, x_p);
-        x_val = Fp2T::add(x_val, term);
-        x_p = Fp2T::mul(x_p, x);
-      }
-
-      // res += px(val) * y^i
-      Fp2T term = Fp2T::mul(x_val, y_pow);
-      res = Fp2T::add(res, term);
-
-      y_pow = Fp2T::mul(y_pow, y);
+    for (size_t i = coeffs.size(); i-- > 0;) {
+      // res = res * y + P_i(x)
+      res = Fp2T::add(Fp2T::mul(res, y), coeffs[i].eval(x));
     }
     return res;
   }
@@ -46,9 +35,9 @@ public:
   // ] But usually we just want to satisfy: Phi(P_new) = E_cross assuming
   // Phi(P1) = 0 and Phi(P2) = 0.
 
+  template <typename Rows>
   static void
-  analyze_phi2(const std::vector<Poly>
-                   &coeffs_y, // Polynomials in X, indexed by power of Y
+  analyze_phi2(const Rows &coeffs_y, // Polynomials in X, indexed by power of Y
                const std::pair<Fp2T, Fp2T> &P1, // (j1, j1')
                const std::pair<Fp2T, Fp2T> &P2, // (j2, j2')
                const Fp2T &r) {
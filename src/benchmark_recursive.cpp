@@ -5,11 +5,298 @@
 
 
 #include "benchmark.hpp"
+#include "commitment_fast.hpp"
+#include "edwards.hpp"
 #include "qhalo_api.hpp"
+#include "vector_commitment.hpp"
 
 
 using namespace crypto;
 
+// One row of the Pedersen table: comb width W against double-and-add
+template <typename P, int W> void pedersen_comb_row() {
+  using Commit = PedersenCommitmentFast<P, W>;
+
+  auto t0 = std::chrono::high_resolution_clock::now();
+  Commit pedersen; // the first instance per W builds the shared tables
+  auto t1 = std::chrono::high_resolution_clock::now();
+  double build_ms =
+      std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+  BigInt<P::N_LIMBS> v, b;
+  for (size_t i = 0; i < P::N_LIMBS; ++i) {
+    v.limbs[i] = 0x9e3779b97f4a7c15ULL * (i + 1);
+    b.limbs[i] = 0xc2b2ae3d27d4eb4fULL * (i + 3);
+  }
+  v.limbs[P::N_LIMBS - 1] >>= 16; // below p
+  b.limbs[P::N_LIMBS - 1] >>= 16;
+  const uint64_t v64 = v.limbs[0], b64 = b.limbs[0];
+
+  auto comb = benchmark(
+      "Commit", [&]() { volatile auto c = pedersen.Commit(v64, b64); }, 100);
+  auto plain = benchmark(
+      "Commit (double-and-add)",
+      [&]() { volatile auto c = pedersen.CommitDoubleAndAdd(v64, b64); }, 100);
+  auto full = benchmark(
+      "CommitFull", [&]() { volatile auto c = pedersen.CommitFull(v, b); }, 20);
+  auto full_plain = benchmark(
+      "CommitFull (double-and-add)",
+      [&]() { volatile auto c = pedersen.CommitFullDoubleAndAdd(v, b); }, 20);
+  auto full_ct = benchmark(
+      "CommitFullCT", [&]() { volatile auto c = pedersen.CommitFullCT(v, b); },
+      5);
+
+  const size_t entries = (size_t)1 << (2 * W);
+  const size_t kb = 2 * entries * sizeof(typename Commit::Point) / 1024;
+  std::cout << "    " << std::setw(2) << W << " │ " << std::setw(7) << entries
+            << " │ " << std::setw(9) << kb << " │ " << std::setw(15)
+            << std::fixed << std::setprecision(1) << build_ms << " │ "
+            << std::setw(12) << comb.median_cycles << " │ " << std::setw(6)
+            << std::setprecision(1)
+            << (double)plain.median_cycles / comb.median_cycles << "x │ "
+            << std::setw(12) << full.median_cycles << " │ " << std::setw(6)
+            << (double)full_plain.median_cycles / full.median_cycles << "x │ "
+            << std::setw(12) << full_ct.median_cycles << "\n";
+}
+
+// Pedersen commitments over the fixed G, H: joint comb tables (two per
+// width, 64-bit and full-width scalars) vs. two double-and-add ladders, and
+// the constant-time comb lookup (a full table scan per column).
+// First ctor is 0 for the default width, whose tables QHALO already built.
+template <typename P> void run_pedersen_comb_benchmarks() {
+  std::cout << "[PEDERSEN COMMIT] joint comb vs. double-and-add\n\n";
+  std::cout << "     W │ Entries │ Tables KB │ First ctor (ms) │ Commit (cyc) │ Speedup │ Full (cyc)   │ Speedup │ Full CT (cyc)\n";
+  std::cout << "    ───┼─────────┼───────────┼─────────────────┼──────────────┼─────────┼──────────────┼─────────┼──────────────\n";
+  pedersen_comb_row<P, 2>();
+  pedersen_comb_row<P, 4>();
+  pedersen_comb_row<P, 6>();
+  std::cout << "\n";
+}
+
+// Variable-base scalar multiplication: double-and-add (ScalarMul) against
+// the wNAF (variable time) and regular signed-window (constant time) ladders
+// for a compose-sized challenge, a 64-bit and a full-width scalar
+template <typename P> void run_scalar_mul_benchmarks() {
+  using Curve = TwistedEdwardsFast<P>;
+  using Scalar = BigInt<P::N_LIMBS>;
+
+  PedersenCommitmentFast<P> pedersen;
+  const Curve &curve = pedersen.GetCurve();
+  auto base = pedersen.Commit(12345, 678);
+
+  Scalar full;
+  for (size_t i = 0; i < P::N_LIMBS; ++i)
+    full.limbs[i] = 0x9e3779b97f4a7c15ULL * (i + 5);
+  full.limbs[P::N_LIMBS - 1] >>= 16; // below p
+  struct Row {
+    const char *name;
+    Scalar k;
+  };
+  const Row rows[] = {{"28-bit (compose)", Scalar(0x9e3779bULL)},
+                      {"64-bit", Scalar(0xc2b2ae3d27d4eb4fULL)},
+                      {"full width", full}};
+
+  std::cout << "[SCALAR MUL] variable base, cycles (median)\n\n";
+  std::cout << "    Scalar           │ Double-and-add │ wNAF w=4     │ wNAF w=5     │ CT w=5       │ wNAF gain\n";
+  std::cout << "    ─────────────────┼────────────────┼──────────────┼──────────────┼──────────────┼──────────\n";
+  for (const Row &row : rows) {
+    const Scalar &k = row.k;
+    auto plain = benchmark(
+        "ScalarMul", [&]() { volatile auto R = curve.ScalarMul(base, k); }, 20);
+    auto w4 = benchmark(
+        "ScalarMulWNAF w=4",
+        [&]() { volatile auto R = curve.ScalarMulWNAF(base, k, 4); }, 20);
+    auto w5 = benchmark(
+        "ScalarMulWNAF w=5",
+        [&]() { volatile auto R = curve.ScalarMulWNAF(base, k, 5); }, 20);
+    auto ct = benchmark(
+        "ScalarMulCT w=5",
+        [&]() { volatile auto R = curve.ScalarMulCT(base, k, 5); }, 20);
+    uint64_t best = std::min(w4.median_cycles, w5.median_cycles);
+    std::cout << "    " << std::left << std::setw(16) << row.name << std::right
+              << " │ " << std::setw(14) << plain.median_cycles << " │ "
+              << std::setw(12) << w4.median_cycles << " │ " << std::setw(12)
+              << w5.median_cycles << " │ " << std::setw(12)
+              << ct.median_cycles << " │ " << std::setw(7) << std::fixed
+              << std::setprecision(1) << (double)plain.median_cycles / best
+              << "x\n";
+  }
+  std::cout << "\n";
+}
+
+// Per-point inversions vs. one shared inversion (Montgomery's trick) for
+// n projective points: Normalize, to_affine and the Montgomery <-> Edwards
+// maps (two inversions per point when done one at a time)
+template <typename P> void run_batch_normalize_benchmarks(size_t n = 1024) {
+  using Curve = TwistedEdwardsFast<P>;
+  using Point = typename Curve::Point;
+  using Fp2T = Fp2<P>;
+  using Mapper = CurveMapper<P>;
+  using Clock = std::chrono::high_resolution_clock;
+
+  PedersenCommitmentFast<P> pedersen;
+  std::vector<Point> pts(n);
+  for (size_t i = 0; i < n; ++i)
+    pts[i] = pedersen.Commit(i + 1, 2 * i + 3); // Z != 1
+  std::vector<EdwardsPoint<P>> ed(n);
+  std::vector<typename Mapper::MontPoint> mont(n);
+  std::vector<Fp2T> xs(n), ys(n);
+  for (size_t i = 0; i < n; ++i)
+    pts[i].to_affine(ed[i].X, ed[i].Y);
+  for (size_t i = 0; i < n; ++i)
+    mont[i] = Mapper::EdwardsToMont(ed[i]);
+
+  auto us_per_point = [&](auto &&fn) {
+    auto t0 = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0)
+               .count() /
+           n;
+  };
+  auto row = [&](const char *name, double single, double batch) {
+    std::cout << "    " << std::left << std::setw(16) << name << std::right
+              << " │ " << std::setw(12) << std::fixed << std::setprecision(2)
+              << single << " │ " << std::setw(11) << batch << " │ "
+              << std::setw(6) << std::setprecision(1) << single / batch
+              << "x\n";
+  };
+
+  std::cout << "[BATCH NORMALIZE] " << n
+            << " points, one inversion per point vs. one shared\n\n";
+  std::cout << "    Operation        │ Single (us)  │ Batch (us)  │ Speedup\n";
+  std::cout << "    ─────────────────┼──────────────┼─────────────┼────────\n";
+
+  std::vector<Point> work = pts;
+  double single = us_per_point([&]() {
+    for (auto &Q : work)
+      Curve::Normalize(Q);
+  });
+  work = pts;
+  double batch = us_per_point([&]() { Curve::NormalizeBatch(work); });
+  row("Normalize", single, batch);
+
+  single = us_per_point([&]() {
+    for (size_t i = 0; i < n; ++i)
+      pts[i].to_affine(xs[i], ys[i]);
+  });
+  batch = us_per_point([&]() { Point::to_affine_batch(pts, xs, ys); });
+  row("to_affine", single, batch);
+
+  std::vector<EdwardsPoint<P>> ed_out(n);
+  single = us_per_point([&]() {
+    for (size_t i = 0; i < n; ++i)
+      ed_out[i] = Mapper::MontToEdwards(mont[i]);
+  });
+  batch = us_per_point([&]() { Mapper::MontToEdwardsBatch(mont, ed_out); });
+  row("MontToEdwards", single, batch);
+
+  std::vector<typename Mapper::MontPoint> mont_out(n);
+  single = us_per_point([&]() {
+    for (size_t i = 0; i < n; ++i)
+      mont_out[i] = Mapper::EdwardsToMont(ed[i]);
+  });
+  batch = us_per_point([&]() { Mapper::EdwardsToMontBatch(ed, mont_out); });
+  row("EdwardsToMont", single, batch);
+  std::cout << "\n";
+}
+
+// Vector Pedersen commitments: Pippenger MSM cost per point from n = 2^4 to
+// 2^max_log_n, full-width and 64-bit scalars. The bases cycle through the
+// first 4096 generators (the MSM cost does not depend on which points they
+// are); the naive column is one double-and-add ScalarMul per point.
+template <typename P> void run_msm_benchmarks(int max_log_n = 20) {
+  using VPC = VectorPedersenCommitment<P>;
+  using MSM = typename VPC::MSM;
+  using Scalar = typename VPC::Scalar;
+  using Clock = std::chrono::high_resolution_clock;
+
+  ThreadPool pool;
+  const size_t base_count = 4096;
+  auto t0 = Clock::now();
+  VPC vpc(base_count, &pool);
+  double gen_ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+  const auto &curve = vpc.GetCurve();
+  const auto &gens = vpc.generators();
+
+  std::cout << "[VECTOR PEDERSEN] Pippenger MSM, " << pool.size()
+            << " thread(s); " << base_count << " generators in "
+            << std::fixed << std::setprecision(1) << gen_ms << " ms\n\n";
+
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  auto next = [&]() {
+    state += 0x9e3779b97f4a7c15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  };
+
+  // Seconds per call, repeated until at least 4096 points went through
+  auto time_msm = [&](const std::vector<typename VPC::Point> &bases,
+                      const std::vector<Scalar> &ks, ThreadPool *p) {
+    size_t reps = std::max<size_t>(1, 4096 / ks.size());
+    auto a = Clock::now();
+    for (size_t r = 0; r < reps; ++r) {
+      volatile auto R = MSM::Mul(curve, bases, ks, p);
+    }
+    return std::chrono::duration<double>(Clock::now() - a).count() / reps;
+  };
+
+  double naive_us;
+  {
+    std::vector<Scalar> ks(16);
+    for (auto &k : ks) {
+      for (auto &l : k.limbs)
+        l = next();
+      k.limbs[P::N_LIMBS - 1] >>= 16; // below p
+    }
+    auto a = Clock::now();
+    volatile auto R = MSM::MulNaive(curve, gens.data(), ks.data(), ks.size());
+    naive_us = std::chrono::duration<double, std::micro>(Clock::now() - a)
+                   .count() /
+               ks.size();
+  }
+
+  std::cout << "    log2 n │  c │ Full (us/pt) │ vs naive │ Threaded (us/pt) │  c │ 64-bit (us/pt)\n";
+  std::cout << "    ───────┼────┼──────────────┼──────────┼──────────────────┼────┼───────────────\n";
+  for (int log_n = 4; log_n <= max_log_n; log_n += 2) {
+    const size_t n = (size_t)1 << log_n;
+    std::vector<typename VPC::Point> bases(n);
+    std::vector<Scalar> full(n), narrow(n);
+    size_t full_bits = 0;
+    for (size_t i = 0; i < n; ++i) {
+      bases[i] = gens[i % base_count];
+      for (auto &l : full[i].limbs)
+        l = next();
+      full[i].limbs[P::N_LIMBS - 1] >>= 16;
+      full_bits = std::max(full_bits, full[i].bit_length());
+      narrow[i] = Scalar(next());
+    }
+
+    double full_s = time_msm(bases, full, nullptr);
+    double threaded_s = pool.size() > 1 ? time_msm(bases, full, &pool) : 0;
+    double narrow_s = time_msm(bases, narrow, nullptr);
+    double full_us = full_s * 1e6 / n;
+
+    std::cout << "    " << std::setw(6) << log_n << " │ " << std::setw(2)
+              << MSM::window(n, full_bits) << " │ "
+              << std::setw(12) << std::setprecision(2) << full_us << " │ "
+              << std::setw(7) << std::setprecision(1) << naive_us / full_us
+              << "x │ ";
+    if (threaded_s > 0)
+      std::cout << std::setw(16) << std::setprecision(2)
+                << threaded_s * 1e6 / n;
+    else
+      std::cout << std::setw(16) << "-";
+    std::cout << " │ " << std::setw(2) << MSM::window(n, 64) << " │ "
+              << std::setw(14) << std::setprecision(2) << narrow_s * 1e6 / n
+              << "\n";
+  }
+  std::cout << "\n    naive: " << std::setprecision(1) << naive_us
+            << " us per point\n\n";
+}
+
 int main() {
   std::cout
       << "═══════════════════════════════════════════════════════════════\n";
@@ -97,6 +384,11 @@ int main() {
             << std::setprecision(4) << extend_bench.mcycles << " │ ~"
             << std::setprecision(2) << extend_bench.mcycles / 3.0 << " ms\n\n";
 
+  run_pedersen_comb_benchmarks<P>();
+  run_batch_normalize_benchmarks<P>();
+  run_scalar_mul_benchmarks<P>();
+  run_msm_benchmarks<P>(20);
+
   // =========================================================================
   // Recursive Depth Scaling
   // =========================================================================
@@ -72,19 +72,77 @@ public:
     return acc == 0;
   }
 
+  // Full product: a * b as a 2N-limb integer (schoolbook)
+  static BigInt<2 * N> mul_wide(const BigInt<N> &a, const BigInt<N> &b) {
+    BigInt<2 * N> r;
+    for (size_t i = 0; i < N; ++i) {
+      Word carry = 0;
+      for (size_t j = 0; j < N; ++j) {
+        Word hi, lo;
+        lo = _umul128(a.limbs[i], b.limbs[j], &hi);
+        unsigned char c = _addcarry_u64(0, lo, r.limbs[i + j], &lo);
+        _addcarry_u64(c, hi, 0, &hi);
+        c = _addcarry_u64(0, lo, carry, &r.limbs[i + j]);
+        _addcarry_u64(c, hi, 0, &carry);
+      }
+      r.limbs[i + N] = carry;
+    }
+    return r;
+  }
+
+  // In-place division by a small word (d < 2^32), returns the remainder.
+  // Works on 32-bit halves so no 128-bit division intrinsic is needed.
+  static Word div_word(BigInt<N> &a, Word d) {
+    Word rem = 0;
+    for (int i = N - 1; i >= 0; --i) {
+      Word hi = (rem << 32) | (a.limbs[i] >> 32);
+      Word qh = hi / d;
+      rem = hi % d;
+      Word lo = (rem << 32) | (a.limbs[i] & 0xFFFFFFFFULL);
+      Word ql = lo / d;
+      rem = lo % d;
+      a.limbs[i] = (qh << 32) | ql;
+    }
+    return rem;
+  }
+
+  // Number of significant bits (0 for zero)
+  size_t bit_length() const {
+    for (int i = N - 1; i >= 0; --i) {
+      if (limbs[i]) {
+        size_t b = 0;
+        for (Word w = limbs[i]; w; w >>= 1)
+          ++b;
+        return i * 64 + b;
+      }
+    }
+    return 0;
+  }
+
   bool get_bit(size_t bit) const {
     if (bit >= N * 64)
       return false;
     return (limbs[bit / 64] >> (bit % 64)) & 1;
   }
 
+  // count (< 64) bits starting at bit pos; bits past the top read as 0
+  Word get_bits(size_t pos, int count) const {
+    size_t limb = pos / 64, off = pos % 64;
+    if (limb >= N)
+      return 0;
+    Word v = limbs[limb] >> off;
+    if (off + count > 64 && limb + 1 < N)
+      v |= limbs[limb + 1] << (64 - off);
+    return v & ((Word(1) << count) - 1);
+  }
+
   // Print for debugging
-  void print() const {
-    std::cout << "0x";
+  void print(std::ostream &os = std::cout) const {
+    os << "0x";
     for (int i = N - 1; i >= 0; --i) {
-      std::cout << std::hex << std::setw(16) << std::setfill('0') << limbs[i];
+      os << std::hex << std::setw(16) << std::setfill('0') << limbs[i];
     }
-    std::cout << std::dec << std::endl;
+    os << std::dec << std::endl;
   }
 };
 
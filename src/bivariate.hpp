@@ -0,0 +1,185 @@
+#pragma once
+
+#include "poly.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+
+// Dense bivariate polynomial with a precompiled evaluation plan
+// Coefficients live in one flat row-major array: dense[i * (deg_x + 1) + j]
+// is the coefficient of X^j Y^i. Evaluation never touches the dense array;
+// it runs nested Horner over the nonzero terms only:
+//
+//   value = (..(R_top(x) y^g + R_next(x)) y^g' + ..) y^(lowest row)
+//
+// where each nonzero row R_i(x) is itself evaluated by Horner from its top
+// term down, multiplying by x^gap between consecutive nonzero terms. So a
+// dense row of degree d costs d multiplications by x, a zero row or term
+// costs nothing, and coefficients are only ever added: for Phi_2 that is
+// 10 multiplications, as for Phi2Analyzer::eval_phi. Gaps above one (sparse
+// Weber rows) read x^gap and y^gap from tables of the largest gap only.
+//
+// symmetric records Phi(X,Y) = Phi(Y,X) (true for every classical and Weber
+// modular polynomial) for callers such as PhiSpecializationCache; Horner
+// has no use for it.
+template <typename CoeffT> class BivariatePoly {
+public:
+  struct Term {
+    uint32_t gap; // power of x applied to the running row value first
+    CoeffT c;
+  };
+
+  // A nonzero row; plan lists them highest power of Y first
+  struct Row {
+    uint32_t begin, end; // terms[begin, end), highest power of X first
+    uint32_t x_tail;     // lowest power of X in the row
+    uint32_t y_gap;      // power of y applied to the running value first
+  };
+
+  size_t deg_x = 0, deg_y = 0;
+  std::vector<CoeffT> dense;
+  bool symmetric = false;
+  std::vector<Term> terms; // nonzero terms, grouped by row
+  std::vector<Row> plan;   // nonzero rows
+  uint32_t y_tail = 0;     // lowest power of Y with a nonzero row
+  uint32_t max_x_gap = 0;  // largest power of x applied in one step
+  uint32_t max_y_gap = 0;
+
+  // The zero polynomial: an empty plan, so eval() returns 0
+  BivariatePoly() {}
+
+  BivariatePoly(size_t dx, size_t dy, std::vector<CoeffT> c)
+      : deg_x(dx), deg_y(dy), dense(std::move(c)) {
+    dense.resize((deg_x + 1) * (deg_y + 1), CoeffT::zero());
+    compile();
+  }
+
+  // rows[i] is the polynomial in X multiplying Y^i (the layout used by
+  // Phi2Analyzer::eval_phi and ModularPolynomial::phi_coeffs)
+  static BivariatePoly from_rows(const std::vector<Polynomial<CoeffT>> &rows) {
+    size_t dy = rows.empty() ? 0 : rows.size() - 1;
+    size_t dx = 0;
+    for (auto &r : rows)
+      if (!r.coeffs.empty())
+        dx = std::max(dx, r.coeffs.size() - 1);
+    std::vector<CoeffT> c((dx + 1) * (dy + 1), CoeffT::zero());
+    for (size_t i = 0; i < rows.size(); ++i)
+      for (size_t j = 0; j < rows[i].coeffs.size(); ++j)
+        c[i * (dx + 1) + j] = rows[i].coeffs[j];
+    return BivariatePoly(dx, dy, std::move(c));
+  }
+
+  std::vector<Polynomial<CoeffT>> to_rows() const {
+    std::vector<Polynomial<CoeffT>> rows(deg_y + 1);
+    for (size_t i = 0; i <= deg_y; ++i)
+      rows[i].coeffs.assign(dense.begin() + i * (deg_x + 1),
+                            dense.begin() + (i + 1) * (deg_x + 1));
+    return rows;
+  }
+
+  // Coefficient of X^j Y^i
+  const CoeffT &coeff(size_t j, size_t i) const {
+    return dense[i * (deg_x + 1) + j];
+  }
+
+  size_t nnz() const { return terms.size(); }
+
+  CoeffT eval(const CoeffT &x, const CoeffT &y) const {
+    if (max_x_gap < 2 && max_y_gap < 2)
+      return horner(x, y, nullptr, nullptr);
+    CoeffT xp[STACK_GAP + 1], yp[STACK_GAP + 1];
+    std::vector<CoeffT> heap_xp, heap_yp;
+    return horner(x, y, powers(x, max_x_gap, xp, heap_xp),
+                  powers(y, max_y_gap, yp, heap_yp));
+  }
+
+  // out[t] = Phi(xs[t], ys[t]), one Horner pass per point
+  void eval_batch(const CoeffT *xs, const CoeffT *ys, CoeffT *out,
+                  size_t n) const {
+    for (size_t t = 0; t < n; ++t)
+      out[t] = eval(xs[t], ys[t]);
+  }
+
+private:
+  static constexpr uint32_t STACK_GAP = 16;
+
+  // X[g] = x^g and Y[g] = y^g for the gaps above one
+  CoeffT horner(const CoeffT &x, const CoeffT &y, const CoeffT *X,
+                const CoeffT *Y) const {
+    CoeffT res = CoeffT::zero();
+    for (const Row &r : plan) {
+      CoeffT v = terms[r.begin].c;
+      for (uint32_t e = r.begin + 1; e < r.end; ++e)
+        v = CoeffT::add(shift(v, x, X, terms[e].gap), terms[e].c);
+      res = CoeffT::add(shift(res, y, Y, r.y_gap), shift(v, x, X, r.x_tail));
+    }
+    return shift(res, y, Y, y_tail);
+  }
+
+  // v * base^g, with pw[g] = base^g when g > 1
+  static CoeffT shift(const CoeffT &v, const CoeffT &base, const CoeffT *pw,
+                      uint32_t g) {
+    if (g == 0)
+      return v;
+    return CoeffT::mul(v, g == 1 ? base : pw[g]);
+  }
+
+  // pw[k] = base^k for 2 <= k <= max_gap (nothing to build for dense rows)
+  static const CoeffT *powers(const CoeffT &base, uint32_t max_gap,
+                              CoeffT *stack, std::vector<CoeffT> &heap) {
+    if (max_gap < 2)
+      return stack;
+    CoeffT *pw = stack;
+    if (max_gap > STACK_GAP) {
+      heap.resize(max_gap + 1);
+      pw = heap.data();
+    }
+    pw[1] = base;
+    for (uint32_t k = 2; k <= max_gap; ++k)
+      pw[k] = CoeffT::mul(pw[k - 1], base);
+    return pw;
+  }
+
+  void compile() {
+    symmetric = deg_x == deg_y;
+    for (size_t i = 0; symmetric && i <= deg_y; ++i)
+      for (size_t j = 0; j < i; ++j)
+        if (!CoeffT::equal(coeff(j, i), coeff(i, j))) {
+          symmetric = false;
+          break;
+        }
+
+    terms.clear();
+    plan.clear();
+    max_x_gap = max_y_gap = y_tail = 0;
+    uint32_t prev_i = 0;
+    for (size_t i = deg_y + 1; i-- > 0;) {
+      Row r{(uint32_t)terms.size(), 0, 0, 0};
+      uint32_t prev_j = 0;
+      for (size_t j = deg_x + 1; j-- > 0;) {
+        const CoeffT &c = coeff(j, i);
+        if (c.is_zero())
+          continue;
+        uint32_t gap = r.begin == terms.size() ? 0 : prev_j - (uint32_t)j;
+        terms.push_back(Term{gap, c});
+        max_x_gap = std::max(max_x_gap, gap);
+        prev_j = (uint32_t)j;
+      }
+      if (r.begin == terms.size())
+        continue;
+      r.end = (uint32_t)terms.size();
+      r.x_tail = prev_j;
+      r.y_gap = plan.empty() ? 0 : prev_i - (uint32_t)i;
+      max_x_gap = std::max(max_x_gap, r.x_tail);
+      max_y_gap = std::max(max_y_gap, r.y_gap);
+      plan.push_back(r);
+      prev_i = (uint32_t)i;
+    }
+    y_tail = plan.empty() ? 0 : prev_i;
+    max_y_gap = std::max(max_y_gap, y_tail);
+  }
+};
+
+} // namespace crypto
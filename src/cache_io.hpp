@@ -0,0 +1,332 @@
+#pragma once
+
+#include "keccak.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <process.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace crypto {
+
+// On-disk cache for precomputed tables
+// File layout: fixed header (magic, format version, payload kind, payload
+// size, SHA3-256 of the payload) followed by the raw payload. Writers go
+// through a temporary file and a rename, so readers never observe a partially
+// written cache; readers reject anything whose header or digest does not
+// match and the caller simply recomputes.
+class CacheIO {
+public:
+  static constexpr uint32_t MAGIC = 0x43484851; // "QHHC"
+
+  // Payload kinds (one per cached table type)
+  static constexpr uint64_t KIND_TORSION_BASIS = 1;
+  static constexpr uint64_t KIND_MODULAR_POLY = 2;
+  static constexpr uint64_t KIND_FOLD_CHECKPOINT = 3;
+  static constexpr uint64_t KIND_PEDERSEN_GENERATORS = 4;
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t kind;
+    uint64_t size;
+    uint8_t digest[32];
+  };
+
+  // Cache directory: $QHALO_CACHE_DIR, or ./.qhalo_cache
+  static std::string cache_dir() {
+    const char *env = std::getenv("QHALO_CACHE_DIR");
+    return (env && *env) ? std::string(env) : std::string(".qhalo_cache");
+  }
+
+  static std::string path_for(const std::string &name) {
+    return (std::filesystem::path(cache_dir()) / name).string();
+  }
+
+  // Hex prefix of a digest, for building file names from content keys
+  static std::string hex(const uint8_t *digest, size_t bytes) {
+    static const char *digits = "0123456789abcdef";
+    std::string s;
+    for (size_t i = 0; i < bytes; ++i) {
+      s.push_back(digits[digest[i] >> 4]);
+      s.push_back(digits[digest[i] & 15]);
+    }
+    return s;
+  }
+
+  static bool write_atomic(const std::string &path, uint64_t kind,
+                           uint32_t version,
+                           const std::vector<uint8_t> &payload,
+                           bool sync = true) {
+    std::error_code ec;
+    std::filesystem::path target(path);
+    if (target.has_parent_path())
+      std::filesystem::create_directories(target.parent_path(), ec);
+
+    Header h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MAGIC;
+    h.version = version;
+    h.kind = kind;
+    h.size = payload.size();
+    sha3_256(payload.data(), payload.size(), h.digest);
+
+    // One temporary file per writer, so concurrent writers of the same cache
+    // entry never share (and rename) each other's half-written file
+    static std::atomic<uint64_t> serial{0};
+    std::string tmp = path + ".tmp." + std::to_string(process_id()) + "." +
+                      std::to_string(serial.fetch_add(1));
+    FILE *f = std::fopen(tmp.c_str(), "wb");
+    if (!f)
+      return false;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && !payload.empty())
+      ok = std::fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+    ok = ok && std::fflush(f) == 0;
+    if (ok && sync)
+      sync_file(f);
+    std::fclose(f);
+    if (!ok) {
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+    std::filesystem::rename(tmp, target, ec);
+    if (ec) {
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+    // The rename lives in the directory: without syncing it, a crash can
+    // still bring back the old entry (or none)
+    if (sync)
+      sync_dir(target.has_parent_path() ? target.parent_path().string()
+                                        : std::string("."));
+    return true;
+  }
+
+  static bool read_validated(const std::string &path, uint64_t kind,
+                             uint32_t version, std::vector<uint8_t> &payload) {
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f)
+      return false;
+    Header h;
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1 && h.magic == MAGIC &&
+              h.version == version && h.kind == kind;
+    // The header size must match the file before anything is allocated
+    std::error_code ec;
+    uint64_t file_size = std::filesystem::file_size(path, ec);
+    ok = ok && !ec && file_size >= sizeof(h) &&
+         h.size == file_size - sizeof(h);
+    if (ok) {
+      payload.resize(h.size);
+      ok = h.size == 0 ||
+           std::fread(payload.data(), 1, h.size, f) == (size_t)h.size;
+    }
+    std::fclose(f);
+    if (!ok)
+      return false;
+    uint8_t digest[32];
+    sha3_256(payload.data(), payload.size(), digest);
+    return memcmp(digest, h.digest, 32) == 0;
+  }
+
+  // Validates an in-memory image of a cache file (e.g. a MappedFile) and
+  // returns a pointer to its payload without copying it.
+  static bool validate(const uint8_t *data, size_t size, uint64_t kind,
+                       uint32_t version, const uint8_t *&payload,
+                       size_t &payload_size) {
+    Header h;
+    if (!data || size < sizeof(h))
+      return false;
+    memcpy(&h, data, sizeof(h));
+    if (h.magic != MAGIC || h.version != version || h.kind != kind ||
+        h.size != size - sizeof(h))
+      return false;
+    uint8_t digest[32];
+    sha3_256(data + sizeof(h), (size_t)h.size, digest);
+    if (memcmp(digest, h.digest, 32) != 0)
+      return false;
+    payload = data + sizeof(h);
+    payload_size = (size_t)h.size;
+    return true;
+  }
+
+  // Raw little helpers for building payloads of trivially copyable values
+  template <typename T>
+  static void put(std::vector<uint8_t> &buf, const T &v) {
+    const uint8_t *p = (const uint8_t *)&v;
+    buf.insert(buf.end(), p, p + sizeof(T));
+  }
+
+  template <typename T>
+  static bool get(const uint8_t *buf, size_t size, size_t &off, T &v) {
+    if (off + sizeof(T) > size)
+      return false;
+    memcpy(&v, buf + off, sizeof(T));
+    off += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  static bool get(const std::vector<uint8_t> &buf, size_t &off, T &v) {
+    return get(buf.data(), buf.size(), off, v);
+  }
+
+  // Fp2 elements as their two Montgomery limb arrays
+  template <typename Fp2T>
+  static void put_fp2(std::vector<uint8_t> &buf, const Fp2T &v) {
+    put(buf, v.c0.val.limbs);
+    put(buf, v.c1.val.limbs);
+  }
+
+  template <typename Fp2T>
+  static bool get_fp2(const uint8_t *buf, size_t size, size_t &off, Fp2T &v) {
+    return get(buf, size, off, v.c0.val.limbs) &&
+           get(buf, size, off, v.c1.val.limbs);
+  }
+
+  template <typename Fp2T>
+  static bool get_fp2(const std::vector<uint8_t> &buf, size_t &off, Fp2T &v) {
+    return get_fp2(buf.data(), buf.size(), off, v);
+  }
+
+  // Makes renames and removals inside dir durable. NTFS journals them, so
+  // there is nothing to do on Windows.
+  static void sync_dir(const std::string &dir) {
+#ifndef _WIN32
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      fsync(fd);
+      ::close(fd);
+    }
+#else
+    (void)dir;
+#endif
+  }
+
+private:
+  static void sync_file(FILE *f) {
+#ifdef _WIN32
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+  }
+
+  static uint64_t process_id() {
+#ifdef _WIN32
+    return (uint64_t)_getpid();
+#else
+    return (uint64_t)getpid();
+#endif
+  }
+};
+
+// Read-only memory mapping of a whole file
+// Pages are shared through the OS page cache, so every process that maps the
+// same cache file reuses one physical copy.
+class MappedFile {
+public:
+  MappedFile() {}
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path) {
+    close();
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) {
+      close();
+      return false;
+    }
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+      close();
+      return false;
+    }
+    ptr = (const uint8_t *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    len = (size_t)sz.QuadPart;
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      close();
+      return false;
+    }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      close();
+      return false;
+    }
+    ptr = (const uint8_t *)p;
+    len = (size_t)st.st_size;
+#endif
+    if (!ptr) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+#ifdef _WIN32
+    if (ptr)
+      UnmapViewOfFile(ptr);
+    if (mapping)
+      CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+      CloseHandle(file);
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (ptr)
+      munmap((void *)ptr, len);
+    if (fd >= 0)
+      ::close(fd);
+    fd = -1;
+#endif
+    ptr = nullptr;
+    len = 0;
+  }
+
+  const uint8_t *data() const { return ptr; }
+  size_t size() const { return len; }
+
+private:
+  const uint8_t *ptr = nullptr;
+  size_t len = 0;
+#ifdef _WIN32
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#else
+  int fd = -1;
+#endif
+};
+
+} // namespace crypto
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "cache_io.hpp"
+#include "fp2.hpp"
+#include "keccak.hpp"
+#include "poly.hpp"
+#include "relaxed_folding.hpp"
+#include "transcript.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+// Everything a folding loop needs to continue after a restart
+// step and cursor are the caller's: folds done so far and the position of
+// its witness source (RNG state, stream offset). extra carries state the
+// loop keeps besides the relaxed accumulator (QHaloProtocol's blinds and
+// commitments). Restoring all of it, including the sponge, makes a resumed
+// run bit-identical to an uninterrupted one.
+//
+// relation names the loop that wrote the checkpoint (relation_tag: loop
+// name, Phi_l and the walk's edge list), so a run never resumes state of
+// another loop or another Phi_l that happens to use the same path.
+//
+// Payload (CacheIO::KIND_FOLD_CHECKPOINT): p, relation, step, cursor, acc as
+// three Fp2 in Montgomery form, the 25 sponge lanes and pt, then extra,
+// length prefixed.
+template <typename Config> struct FoldCheckpoint {
+  using Fp2T = Fp2<Config>;
+  using Poly = Polynomial<Fp2T>;
+  using Witness = typename RelaxedIsogenyFolder<Config>::RelaxedWitness;
+  using Sponge = typename Transcript<Config>::SpongeState;
+  using Tag = std::array<uint8_t, 32>;
+
+  Tag relation{};
+  uint64_t step = 0;
+  uint64_t cursor = 0;
+  Witness acc = Witness::zero();
+  Sponge sponge{};
+  std::vector<uint8_t> extra;
+
+  std::vector<uint8_t> encode() const {
+    std::vector<uint8_t> buf;
+    CacheIO::put(buf, Config::p().limbs);
+    CacheIO::put(buf, relation);
+    CacheIO::put(buf, step);
+    CacheIO::put(buf, cursor);
+    CacheIO::put_fp2(buf, acc.j_start);
+    CacheIO::put_fp2(buf, acc.j_end);
+    CacheIO::put_fp2(buf, acc.u);
+    CacheIO::put(buf, sponge.lanes);
+    CacheIO::put(buf, sponge.pt);
+    CacheIO::put(buf, (uint64_t)extra.size());
+    buf.insert(buf.end(), extra.begin(), extra.end());
+    return buf;
+  }
+
+  // false on a truncated payload or one written for another p
+  bool decode(const std::vector<uint8_t> &buf) {
+    size_t off = 0;
+    auto p = Config::p().limbs;
+    uint64_t n_extra;
+    if (!CacheIO::get(buf, off, p) || p != Config::p().limbs ||
+        !CacheIO::get(buf, off, relation) || !CacheIO::get(buf, off, step) || !CacheIO::get(buf, off, cursor) ||
+        !CacheIO::get_fp2(buf, off, acc.j_start) ||
+        !CacheIO::get_fp2(buf, off, acc.j_end) ||
+        !CacheIO::get_fp2(buf, off, acc.u) ||
+        !CacheIO::get(buf, off, sponge.lanes) ||
+        !CacheIO::get(buf, off, sponge.pt) ||
+        !CacheIO::get(buf, off, n_extra) || n_extra != buf.size() - off)
+      return false;
+    extra.assign(buf.begin() + off, buf.end());
+    return true;
+  }
+
+  // SHA3-256 over (loop, p, the rows of Phi_l, the edges the loop walks)
+  static Tag relation_tag(const char *loop, const std::vector<Poly> &coeffs_y,
+                          const std::vector<std::pair<Fp2T, Fp2T>> &edges) {
+    std::vector<uint8_t> buf(loop, loop + strlen(loop));
+    CacheIO::put(buf, Config::p().limbs);
+    CacheIO::put(buf, (uint64_t)coeffs_y.size());
+    for (const Poly &row : coeffs_y) {
+      CacheIO::put(buf, (uint64_t)row.coeffs.size());
+      for (const Fp2T &c : row.coeffs)
+        CacheIO::put_fp2(buf, c);
+    }
+    CacheIO::put(buf, (uint64_t)edges.size());
+    for (const auto &e : edges) {
+      CacheIO::put_fp2(buf, e.first);
+      CacheIO::put_fp2(buf, e.second);
+    }
+    Tag tag;
+    sha3_256(buf.data(), buf.size(), tag.data());
+    return tag;
+  }
+};
+
+// Periodic checkpoints of a folding loop, with batched fsync
+// Every write is atomic (CacheIO::write_atomic: temporary file, rename), but
+// only every sync_every-th one pays for an fsync. Synced checkpoints go to
+// `path`, the others to `path`.recent. A synced write fsyncs the file and,
+// after the rename, its directory before the recent slot is removed, so a
+// crash of the machine can at worst lose the recent slot, never the synced
+// one. load() takes the newer of the two slots that pass validation and
+// carry the caller's relation tag.
+template <typename Config> class Checkpointer {
+public:
+  using Checkpoint = FoldCheckpoint<Config>;
+
+  static constexpr uint32_t VERSION = 2; // 2: relation tag
+  static constexpr uint64_t DEFAULT_EVERY = 4096;
+  static constexpr uint64_t DEFAULT_SYNC_EVERY = 16;
+
+  std::string path;
+  uint64_t every;      // steps between checkpoints, 0 = never
+  uint64_t sync_every; // checkpoints per fsync, 1 = every one
+
+  // Since construction
+  uint64_t writes = 0;
+  uint64_t syncs = 0;
+  uint64_t failures = 0;
+
+  explicit Checkpointer(const std::string &path,
+                        uint64_t every = DEFAULT_EVERY,
+                        uint64_t sync_every = DEFAULT_SYNC_EVERY)
+      : path(path), every(every), sync_every(sync_every ? sync_every : 1) {}
+
+  bool due(uint64_t step) const { return every && step % every == 0; }
+
+  bool save(const Checkpoint &c) {
+    return write(c, ++writes % sync_every == 0);
+  }
+
+  // A durable checkpoint regardless of the schedule (end of a run)
+  bool save_synced(const Checkpoint &c) {
+    ++writes;
+    return write(c, true);
+  }
+
+  // The newest checkpoint written for relation (FoldCheckpoint::relation_tag)
+  bool load(Checkpoint &out, const typename Checkpoint::Tag &relation) const {
+    Checkpoint synced, recent;
+    bool has_synced = read(path, synced) && synced.relation == relation;
+    bool has_recent =
+        read(recent_path(), recent) && recent.relation == relation;
+    if (has_recent && (!has_synced || recent.step > synced.step)) {
+      out = std::move(recent);
+      return true;
+    }
+    if (has_synced)
+      out = std::move(synced);
+    return has_synced;
+  }
+
+  void remove() const {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(recent_path(), ec);
+  }
+
+private:
+  std::string recent_path() const { return path + ".recent"; }
+
+  bool write(const Checkpoint &c, bool sync) {
+    bool ok = CacheIO::write_atomic(sync ? path : recent_path(),
+                                    CacheIO::KIND_FOLD_CHECKPOINT, VERSION,
+                                    c.encode(), sync);
+    if (ok && sync) {
+      ++syncs;
+      // the synced slot is now the newer one and its rename is on disk
+      // (write_atomic syncs the directory); drop the stale recent slot
+      std::error_code ec;
+      std::filesystem::remove(recent_path(), ec);
+    }
+    if (!ok) {
+      ++failures;
+      std::cerr << "Checkpointer: could not write " << path << " (step "
+                << c.step << ")" << std::endl;
+    }
+    return ok;
+  }
+
+  static bool read(const std::string &file, Checkpoint &out) {
+    std::vector<uint8_t> buf;
+    return CacheIO::read_validated(file, CacheIO::KIND_FOLD_CHECKPOINT,
+                                   VERSION, buf) &&
+           out.decode(buf);
+  }
+};
+
+} // namespace crypto
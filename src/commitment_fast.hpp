@@ -8,35 +8,61 @@ namespace crypto {
 // Optimized Pedersen Commitment using Fast Edwards Curves
 // Uses extended projective coordinates for 100-200x speedup
 // C = [value] * G + [blind] * H
-template <typename Config> class PedersenCommitmentFast {
+// G and H are fixed, so both commit paths go through joint comb tables
+// (JointFixedBaseComb, W bits per base and column, 2^(2W) entries): one for
+// 64-bit scalars (Commit) and one for full-width scalars (CommitFull). The
+// tables are built by the first instance and shared by every later one.
+//
+// Commit and CommitFull are NOT constant time: the comb indexes its table
+// with value and blind bits, so cache timing can leak them. CommitCT and
+// CommitFullCT scan the whole table per column (JointFixedBaseComb::MulCT)
+// and should be used when the committed values must stay hidden from a
+// co-located observer.
+template <typename Config, int W = 4> class PedersenCommitmentFast {
 public:
   using Fp2T = Fp2<Config>;
   using Curve = TwistedEdwardsFast<Config>;
   using Point = typename Curve::Point;
+  using Comb = JointFixedBaseComb<Config, W>;
+
+  static constexpr int COMB_WIDTH = W;
 
 private:
   Curve curve;
   Point G; // Generator 1
   Point H; // Generator 2
 
+  struct CombTables {
+    Comb narrow; // 64-bit scalars
+    Comb full;   // N_LIMBS * 64-bit scalars
+  };
+  const CombTables *combs = nullptr;
+
+  // G, H and the curve are the same for every instance of a Config
+  static const CombTables &comb_tables(const Curve &c, const Point &G,
+                                       const Point &H) {
+    static const CombTables tables{Comb(c, G, H, 64), Comb(c, G, H)};
+    return tables;
+  }
+
 public:
+  // The default curve: a = 6, d = 4 (Montgomery form)
+  static Curve DefaultCurve() {
+    Fp2T a, d;
+    a.c0.val.limbs[0] = 6;
+    a.c0 = a.c0.to_montgomery();
+    a.c1 = Fp2T::FpT::zero();
+    d.c0.val.limbs[0] = 4;
+    d.c0 = d.c0.to_montgomery();
+    d.c1 = Fp2T::FpT::zero();
+    return Curve(a, d);
+  }
+
   // Initialize with default Edwards curve parameters
-  PedersenCommitmentFast()
-      : curve([this]() {
-          // Create curve parameters in Montgomery form
-          Fp2T a, d;
-          // a = 6 (in Montgomery form)
-          a.c0.val.limbs[0] = 6;
-          a.c0 = a.c0.to_montgomery();
-          a.c1 = Fp2T::FpT::zero();
-          // d = 4 (in Montgomery form)
-          d.c0.val.limbs[0] = 4;
-          d.c0 = d.c0.to_montgomery();
-          d.c1 = Fp2T::FpT::zero();
-          return Curve(a, d);
-        }()) {
+  PedersenCommitmentFast() : curve(DefaultCurve()) {
     // Initialize generators with fixed points
     InitGenerators();
+    combs = &comb_tables(curve, G, H);
   }
 
   void InitGenerators() {
@@ -77,23 +103,35 @@ public:
 
   // Commit to a value with a blinding factor (64-bit version)
   // C = [value] * G + [blind] * H
+  // 64 / W doublings and additions for both scalars together
   Point Commit(uint64_t value, uint64_t blind) const {
-    // [value] * G using fast scalar mul
-    Point vG = curve.ScalarMul64(G, value);
-
-    // [blind] * H using fast scalar mul
-    Point bH = curve.ScalarMul64(H, blind);
-
-    // C = vG + bH (single addition in projective)
-    return curve.Add(vG, bH);
+    return combs->narrow.Mul(value, blind);
   }
 
   // Commit with full BigInt scalar
   Point CommitFull(const BigInt<Config::N_LIMBS> &value,
                    const BigInt<Config::N_LIMBS> &blind) const {
-    Point vG = curve.ScalarMul(G, value);
-    Point bH = curve.ScalarMul(H, blind);
-    return curve.Add(vG, bH);
+    return combs->full.Mul(value, blind);
+  }
+
+  // Commit and CommitFull with constant-time table lookups
+  Point CommitCT(uint64_t value, uint64_t blind) const {
+    return combs->narrow.MulCT(value, blind);
+  }
+
+  Point CommitFullCT(const BigInt<Config::N_LIMBS> &value,
+                     const BigInt<Config::N_LIMBS> &blind) const {
+    return combs->full.MulCT(value, blind);
+  }
+
+  // The double-and-add paths the combs replace, for comparison
+  Point CommitDoubleAndAdd(uint64_t value, uint64_t blind) const {
+    return curve.Add(curve.ScalarMul64(G, value), curve.ScalarMul64(H, blind));
+  }
+
+  Point CommitFullDoubleAndAdd(const BigInt<Config::N_LIMBS> &value,
+                               const BigInt<Config::N_LIMBS> &blind) const {
+    return curve.Add(curve.ScalarMul(G, value), curve.ScalarMul(H, blind));
   }
 
   // Add two commitment points (projective addition - no inversion!)
@@ -101,9 +139,10 @@ public:
     return curve.Add(C1, C2);
   }
 
-  // Scalar multiply a commitment point with 64-bit scalar
+  // Scalar multiply a commitment point with 64-bit scalar (wNAF; the
+  // scalars here are public Fiat-Shamir challenges)
   Point ScalarMul(const Point &C, uint64_t scalar) const {
-    return curve.ScalarMul64(C, scalar);
+    return curve.ScalarMul64WNAF(C, scalar);
   }
 
   // Check if two commitment points are equal (projective comparison)
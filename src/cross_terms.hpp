@@ -0,0 +1,238 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "relaxed_folding.hpp"
+#include "small_poly.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+
+// Cross-term coefficients of one (w1, w2) pair, see CrossTermEngine.
+// t[d] multiplies r^d for d = 1 .. degree; t[0] is unused (zero).
+template <typename Config, size_t MaxDeg> struct CrossTerms {
+  using Fp2T = Fp2<Config>;
+
+  size_t degree = 0;
+  std::array<Fp2T, MaxDeg + 1> t;
+
+  // E(r) = sum_{d >= 1} t[d] r^d, Horner from the top
+  Fp2T eval(const Fp2T &r) const {
+    Fp2T e = Fp2T::zero();
+    for (size_t d = degree; d >= 1; --d)
+      e = Fp2T::mul(Fp2T::add(e, t[d]), r);
+    return e;
+  }
+};
+
+// Cross terms of one k-ary fold, see CrossTermEngine::cross_terms_many.
+// t[d] multiplies r^d for d = 1 .. D k; t[0] is unused (zero).
+template <typename Config> struct MultiCrossTerms {
+  using Fp2T = Fp2<Config>;
+
+  std::vector<Fp2T> t;
+
+  Fp2T eval(const Fp2T &r) const {
+    Fp2T e = Fp2T::zero();
+    for (size_t d = t.size(); d-- > 1;)
+      e = Fp2T::mul(Fp2T::add(e, t[d]), r);
+    return e;
+  }
+};
+
+// Symbolic cross terms for relaxed Phi_l folding
+// With x(r) = x1 + r x2 and y(r) = y1 + r y2, Phi(x(r), y(r)) is a
+// polynomial in r of degree D = max{i + j : c_ij != 0} (4 for Phi_2, 6 for
+// Phi_3):
+//
+//   Phi(w1 + r w2) = e_0 + e_1 r + ... + e_D r^D,   e_0 = Phi(w1).
+//
+// expand() computes e_0 .. e_D once per pair. e_0 is never needed by the
+// fold: the accumulator already carries u1 = Phi(w1). The prover publishes
+//
+//   T_1 = e_1 - u2,   T_d = e_d  (d >= 2)
+//
+// before the challenge r is drawn (Transcript::Absorb(CrossTerms)), and the
+// fold itself is
+//
+//   w_new = w1 + r w2,   u_new = u1 + r u2 + sum_{d >= 1} T_d r^d,
+//
+// one degree-D Horner pass instead of three Phi evaluations. If w1 satisfies
+// the relaxed relation Phi(w1) = u1 then u_new = Phi(w_new) for every r,
+// whatever u2 is. For such w1 and u2 = Phi(w2) the result equals
+// RelaxedIsogenyFolder::fold.
+//
+// k fresh witnesses fold in one round with powers of a single challenge
+// (multi-folding as in ProtoStar / HyperNova):
+//
+//   w_new = w_0 + r w_1 + r^2 w_2 + ... + r^k w_k,
+//
+// Phi(w_new) has degree D k in r, T_d = e_d - u_d for d <= k and e_d above,
+// and u_new = u_0 + sum_i r^i u_i + sum_d T_d r^d as before. One expansion,
+// one transcript squeeze and one Horner pass cover all k witnesses.
+template <typename Config, size_t MaxDeg = 8> class CrossTermEngine {
+  using Fp2T = Fp2<Config>;
+  using Folder = RelaxedIsogenyFolder<Config>;
+  using Witness = typename Folder::RelaxedWitness;
+
+public:
+  using RPoly = SmallPoly<Fp2T, MaxDeg>; // polynomial in r
+  using Terms = CrossTerms<Config, MaxDeg>;
+  using MultiTerms = MultiCrossTerms<Config>;
+
+  // Nonzero coefficients c_ij of X^j Y^i, grouped by row i
+  struct Term {
+    uint32_t j;
+    Fp2T c;
+  };
+
+  size_t deg_x = 0, deg_y = 0;
+  size_t degree = 0; // total degree D
+  std::vector<Term> terms;
+  // Row i is terms[row_start[i], row_start[i + 1])
+  std::vector<uint32_t> row_start;
+
+  CrossTermEngine() {}
+
+  // D must not exceed MaxDeg (true for every Phi_l with l <= 3)
+  explicit CrossTermEngine(const BivariatePoly<Fp2T> &phi)
+      : deg_x(phi.deg_x), deg_y(phi.deg_y) {
+    for (size_t i = 0; i <= deg_y; ++i) {
+      row_start.push_back((uint32_t)terms.size());
+      for (size_t j = 0; j <= deg_x; ++j) {
+        const Fp2T &c = phi.coeff(j, i);
+        if (c.is_zero())
+          continue;
+        terms.push_back(Term{(uint32_t)j, c});
+        degree = std::max(degree, i + j);
+      }
+    }
+    row_start.push_back((uint32_t)terms.size());
+    assert(degree <= MaxDeg);
+  }
+
+  explicit CrossTermEngine(const std::vector<Polynomial<Fp2T>> &rows)
+      : CrossTermEngine(BivariatePoly<Fp2T>::from_rows(rows)) {}
+
+  // e_0 .. e_D of Phi(x1 + r x2, y1 + r y2): the powers x(r)^j are shared by
+  // all rows, then Horner in y(r) over the row polynomials.
+  RPoly expand(const Fp2T &x1, const Fp2T &y1, const Fp2T &x2,
+               const Fp2T &y2) const {
+    RPoly xr, yr;
+    xr.coeffs[0] = x1;
+    xr.coeffs[1] = x2;
+    xr.len = 2;
+    yr.coeffs[0] = y1;
+    yr.coeffs[1] = y2;
+    yr.len = 2;
+
+    std::array<RPoly, MaxDeg + 1> xpow;
+    xpow[0] = RPoly(Fp2T::one());
+    for (size_t j = 1; j <= deg_x; ++j)
+      RPoly::mul_into(xpow[j], xpow[j - 1], xr);
+
+    RPoly acc, row, tmp;
+    for (size_t i = deg_y + 1; i-- > 0;) {
+      row.len = 0;
+      for (uint32_t e = row_start[i]; e < row_start[i + 1]; ++e) {
+        RPoly::scale_into(tmp, xpow[terms[e].j], terms[e].c);
+        RPoly::add_into(row, row, tmp);
+      }
+      RPoly::mul_into(acc, acc, yr);
+      RPoly::add_into(acc, acc, row);
+    }
+    return acc;
+  }
+
+  RPoly expand(const Witness &w1, const Witness &w2) const {
+    return expand(w1.j_start, w1.j_end, w2.j_start, w2.j_end);
+  }
+
+  // Prover side: the coefficients to commit to before r is known
+  Terms cross_terms(const Witness &w1, const Witness &w2) const {
+    RPoly e = expand(w1, w2);
+    Terms T;
+    T.degree = degree;
+    for (size_t d = 0; d <= degree; ++d)
+      T.t[d] = (d >= 1 && d < e.len) ? e.coeffs[d] : Fp2T::zero();
+    T.t[1] = Fp2T::sub(T.t[1], w2.u);
+    return T;
+  }
+
+  // Verifier side: no Phi evaluation at all
+  static Witness fold(const Witness &w1, const Witness &w2, const Terms &T,
+                      const Fp2T &r) {
+    Fp2T j_start_new = Fp2T::add(w1.j_start, Fp2T::mul(r, w2.j_start));
+    Fp2T j_end_new = Fp2T::add(w1.j_end, Fp2T::mul(r, w2.j_end));
+    Fp2T u_new = Fp2T::add(Fp2T::add(w1.u, Fp2T::mul(r, w2.u)), T.eval(r));
+    return Witness{j_start_new, j_end_new, u_new};
+  }
+
+  // e_0 .. e_{D k} of Phi(w_0 + r w_1 + ... + r^k w_k), w_0 = acc. Same pass
+  // as expand() on heap polynomials, since the degree grows with k.
+  Polynomial<Fp2T> expand_many(const Witness &acc,
+                               const std::vector<Witness> &fresh) const {
+    using Poly = Polynomial<Fp2T>;
+    const size_t k = fresh.size();
+    std::vector<Fp2T> xc(k + 1), yc(k + 1);
+    xc[0] = acc.j_start;
+    yc[0] = acc.j_end;
+    for (size_t i = 0; i < k; ++i) {
+      xc[i + 1] = fresh[i].j_start;
+      yc[i + 1] = fresh[i].j_end;
+    }
+    Poly xr(std::move(xc)), yr(std::move(yc));
+
+    std::vector<Poly> xpow(deg_x + 1);
+    xpow[0] = Poly(Fp2T::one());
+    for (size_t j = 1; j <= deg_x; ++j)
+      xpow[j] = Poly::mul(xpow[j - 1], xr);
+
+    Poly e;
+    for (size_t i = deg_y + 1; i-- > 0;) {
+      Poly row(std::vector<Fp2T>(deg_x * k + 1, Fp2T::zero()));
+      for (uint32_t t = row_start[i]; t < row_start[i + 1]; ++t) {
+        const Poly &xp = xpow[terms[t].j];
+        for (size_t d = 0; d < xp.coeffs.size(); ++d)
+          row.coeffs[d] = Fp2T::add(row.coeffs[d],
+                                    Fp2T::mul(terms[t].c, xp.coeffs[d]));
+      }
+      e = Poly::add(Poly::mul(e, yr), row);
+    }
+    return e;
+  }
+
+  // Prover side of a k-ary fold
+  MultiTerms cross_terms_many(const Witness &acc,
+                              const std::vector<Witness> &fresh) const {
+    Polynomial<Fp2T> e = expand_many(acc, fresh);
+    MultiTerms T;
+    T.t.assign(degree * fresh.size() + 1, Fp2T::zero());
+    for (size_t d = 1; d < T.t.size() && d < e.coeffs.size(); ++d)
+      T.t[d] = e.coeffs[d];
+    for (size_t i = 0; i < fresh.size(); ++i)
+      T.t[i + 1] = Fp2T::sub(T.t[i + 1], fresh[i].u);
+    return T;
+  }
+
+  // Verifier side of a k-ary fold
+  static Witness fold_many(const Witness &acc, const std::vector<Witness> &fresh,
+                           const MultiTerms &T, const Fp2T &r) {
+    Witness w = acc;
+    Fp2T rp = r; // r^i
+    for (const Witness &f : fresh) {
+      w.j_start = Fp2T::add(w.j_start, Fp2T::mul(rp, f.j_start));
+      w.j_end = Fp2T::add(w.j_end, Fp2T::mul(rp, f.j_end));
+      w.u = Fp2T::add(w.u, Fp2T::mul(rp, f.u));
+      rp = Fp2T::mul(rp, r);
+    }
+    w.u = Fp2T::add(w.u, T.eval(r));
+    return w;
+  }
+};
+
+} // namespace crypto
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "fp2.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace crypto {
 
@@ -276,9 +278,7 @@ public:
     static FullPoint infinity() {
       // Point at infinity (0:1:0) usually in Weierstrass.
       // In Montgomery, (0:0:0) is invalid. Infinite point O is (0:1:0).
-      Fp2T zero;                         // default 0
-      Fp2T one = Fp<Config>::mont_one(); // Need Fp2 one.
-                                         // Fp2 one constructor
+      Fp2T zero; // default 0
       Fp2T one_fp2;
       one_fp2.c0 = Fp<Config>::mont_one();
       return FullPoint{zero, one_fp2, zero};
@@ -420,6 +420,167 @@ public:
     }
     return curr;
   }
+
+  // Straus / Shamir multi-scalar multiplication with interleaved windows
+  //   out[s] = sum_j [k_j] sums[s][j]
+  // Every sum uses the same scalars (the P and Q of folded witnesses), so
+  // the window digits are extracted once and all sums advance through one
+  // loop: per window, `window` doublings of each accumulator, then one
+  // table addition per point. Points are affine (Z = 1) or infinity (Z = 0);
+  // results are affine with one inversion for all sums.
+  // Internally y^2 = x^3 + Ax^2 + x is moved to y^2 = u^3 + a u + b by
+  // x = u - A/3 and runs in Jacobian coordinates, so neither the tables nor
+  // the chain pay an inversion, and doubling / inverse points are handled.
+  static std::vector<FullPoint>
+  multi_scalar_mul(const std::vector<std::vector<FullPoint>> &sums,
+                   const std::vector<BigInt<Config::N_LIMBS>> &ks,
+                   const Fp2T &A, unsigned window = 4) {
+    const size_t n = ks.size();
+    const size_t width = (size_t)1 << window;
+    const Fp2T third = Fp2T::inv(small(3));
+    const Fp2T A3 = Fp2T::mul(A, third); // x = u - A/3
+    // a = 1 - A^2/3
+    const Fp2T a = Fp2T::sub(Fp2T::one(), Fp2T::mul(Fp2T::sqr(A), third));
+
+    // tables[s][j][d] = [d] sums[s][j], d < 2^window
+    std::vector<std::vector<std::vector<JacPoint>>> tables(sums.size());
+    for (size_t s = 0; s < sums.size(); ++s) {
+      tables[s].resize(n);
+      for (size_t j = 0; j < n; ++j) {
+        auto &t = tables[s][j];
+        t.resize(width);
+        t[0] = JacPoint::infinity();
+        if (width > 1)
+          t[1] = to_jacobian(sums[s][j], A3);
+        for (size_t d = 2; d < width; ++d)
+          t[d] = d % 2 ? jac_add(t[d - 1], t[1], a) : jac_dbl(t[d / 2], a);
+      }
+    }
+
+    size_t bits = 0;
+    for (const auto &k : ks)
+      bits = std::max(bits, k.bit_length());
+    const size_t windows = (bits + window - 1) / window;
+
+    std::vector<JacPoint> acc(sums.size(), JacPoint::infinity());
+    std::vector<unsigned> digit(n);
+    for (size_t w = windows; w-- > 0;) {
+      for (size_t j = 0; j < n; ++j) {
+        unsigned d = 0;
+        for (unsigned b = window; b-- > 0;)
+          d = (d << 1) | (unsigned)ks[j].get_bit(w * window + b);
+        digit[j] = d;
+      }
+      for (size_t s = 0; s < sums.size(); ++s) {
+        if (w + 1 != windows)
+          for (unsigned b = 0; b < window; ++b)
+            acc[s] = jac_dbl(acc[s], a);
+        for (size_t j = 0; j < n; ++j)
+          if (digit[j])
+            acc[s] = jac_add(acc[s], tables[s][j][digit[j]], a);
+      }
+    }
+
+    // Back to affine Montgomery, one shared inversion (Montgomery's trick)
+    std::vector<FullPoint> out(sums.size(), FullPoint::infinity());
+    std::vector<Fp2T> prefix(sums.size() + 1, Fp2T::one());
+    for (size_t s = 0; s < sums.size(); ++s)
+      prefix[s + 1] = acc[s].Z.is_zero() ? prefix[s]
+                                         : Fp2T::mul(prefix[s], acc[s].Z);
+    Fp2T inv = Fp2T::inv(prefix.back());
+    for (size_t s = sums.size(); s-- > 0;) {
+      const JacPoint &P = acc[s];
+      if (P.Z.is_zero())
+        continue;
+      Fp2T zi = Fp2T::mul(inv, prefix[s]);
+      inv = Fp2T::mul(inv, P.Z);
+      Fp2T zi2 = Fp2T::sqr(zi);
+      out[s].X = Fp2T::sub(Fp2T::mul(P.X, zi2), A3);
+      out[s].Y = Fp2T::mul(P.Y, Fp2T::mul(zi2, zi));
+      out[s].Z = Fp2T::one();
+    }
+    return out;
+  }
+
+private:
+  // Short Weierstrass Jacobian point (X/Z^2, Y/Z^3); Z = 0 is infinity
+  struct JacPoint {
+    Fp2T X, Y, Z;
+    static JacPoint infinity() {
+      return JacPoint{Fp2T::one(), Fp2T::one(), Fp2T::zero()};
+    }
+  };
+
+  static Fp2T small(uint64_t v) {
+    Fp2T r;
+    r.c0 = FpT(BigInt<Config::N_LIMBS>(v)).to_montgomery();
+    return r;
+  }
+
+  static JacPoint to_jacobian(const FullPoint &P, const Fp2T &A3) {
+    if (P.Z.is_zero())
+      return JacPoint::infinity();
+    Fp2T x = P.X, y = P.Y;
+    if (!Fp2T::equal(P.Z, Fp2T::one())) {
+      Fp2T zi = Fp2T::inv(P.Z);
+      x = Fp2T::mul(x, zi);
+      y = Fp2T::mul(y, zi);
+    }
+    return JacPoint{Fp2T::add(x, A3), y, Fp2T::one()};
+  }
+
+  // dbl-2007-bl
+  static JacPoint jac_dbl(const JacPoint &P, const Fp2T &a) {
+    if (P.Z.is_zero() || P.Y.is_zero())
+      return JacPoint::infinity();
+    Fp2T XX = Fp2T::sqr(P.X);
+    Fp2T YY = Fp2T::sqr(P.Y);
+    Fp2T YYYY = Fp2T::sqr(YY);
+    Fp2T ZZ = Fp2T::sqr(P.Z);
+    Fp2T S = Fp2T::sub(Fp2T::sub(Fp2T::sqr(Fp2T::add(P.X, YY)), XX), YYYY);
+    S = Fp2T::add(S, S);
+    Fp2T M = Fp2T::add(Fp2T::add(XX, XX), XX);
+    M = Fp2T::add(M, Fp2T::mul(a, Fp2T::sqr(ZZ)));
+    Fp2T T = Fp2T::sub(Fp2T::sqr(M), Fp2T::add(S, S));
+    Fp2T Y8 = Fp2T::add(YYYY, YYYY);
+    Y8 = Fp2T::add(Y8, Y8);
+    Y8 = Fp2T::add(Y8, Y8);
+    JacPoint R;
+    R.X = T;
+    R.Y = Fp2T::sub(Fp2T::mul(M, Fp2T::sub(S, T)), Y8);
+    R.Z = Fp2T::sub(Fp2T::sub(Fp2T::sqr(Fp2T::add(P.Y, P.Z)), YY), ZZ);
+    return R;
+  }
+
+  // add-2007-bl, falling back to doubling for P = Q
+  static JacPoint jac_add(const JacPoint &P, const JacPoint &Q,
+                          const Fp2T &a) {
+    if (P.Z.is_zero())
+      return Q;
+    if (Q.Z.is_zero())
+      return P;
+    Fp2T Z1Z1 = Fp2T::sqr(P.Z);
+    Fp2T Z2Z2 = Fp2T::sqr(Q.Z);
+    Fp2T U1 = Fp2T::mul(P.X, Z2Z2);
+    Fp2T U2 = Fp2T::mul(Q.X, Z1Z1);
+    Fp2T S1 = Fp2T::mul(P.Y, Fp2T::mul(Q.Z, Z2Z2));
+    Fp2T S2 = Fp2T::mul(Q.Y, Fp2T::mul(P.Z, Z1Z1));
+    Fp2T H = Fp2T::sub(U2, U1);
+    Fp2T r = Fp2T::sub(S2, S1);
+    if (H.is_zero())
+      return r.is_zero() ? jac_dbl(P, a) : JacPoint::infinity();
+    r = Fp2T::add(r, r);
+    Fp2T I = Fp2T::sqr(Fp2T::add(H, H));
+    Fp2T J = Fp2T::mul(H, I);
+    Fp2T V = Fp2T::mul(U1, I);
+    JacPoint R;
+    R.X = Fp2T::sub(Fp2T::sub(Fp2T::sqr(r), J), Fp2T::add(V, V));
+    Fp2T S1J = Fp2T::mul(S1, J);
+    R.Y = Fp2T::sub(Fp2T::mul(r, Fp2T::sub(V, R.X)), Fp2T::add(S1J, S1J));
+    R.Z = Fp2T::mul(
+        Fp2T::sub(Fp2T::sub(Fp2T::sqr(Fp2T::add(P.Z, Q.Z)), Z1Z1), Z2Z2), H);
+    return R;
+  }
 };
 
 } // namespace crypto
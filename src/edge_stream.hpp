@@ -0,0 +1,134 @@
+#pragma once
+
+#include "fp2.hpp"
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+// Compact binary stream of isogeny-graph edges
+// Header: magic "QHEG", format version, l, N_LIMBS (uint32 each). Then a
+// sequence of records, each starting with a one-byte tag:
+//   NODE  j as 2 * N_LIMBS limbs (c0 then c1, Montgomery form); defines the
+//         next node id 0, 1, 2, ...
+//   EDGE  two uint32 node ids (from, to), Phi_l(j_from, j_to) = 0
+// Every node is written before the first edge that uses it, so one pass with
+// a table of the j seen so far decodes the stream. An edge costs 9 bytes
+// instead of the 4 * N_LIMBS * 8 of a raw (j, j') pair (224 bytes at p434).
+// Integers are stored in host byte order, like the CacheIO payloads.
+struct EdgeStreamFormat {
+  static constexpr uint32_t MAGIC = 0x47454851; // "QHEG"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint8_t TAG_NODE = 1;
+  static constexpr uint8_t TAG_EDGE = 2;
+};
+
+template <typename Config> class EdgeStreamWriter {
+  using Fp2T = Fp2<Config>;
+
+public:
+  uint32_t nodes = 0;  // ids handed out so far
+  uint64_t edges = 0;
+  uint64_t bytes = 0;
+
+  EdgeStreamWriter(std::ostream &os, int l) : os(os) {
+    put((uint32_t)EdgeStreamFormat::MAGIC);
+    put((uint32_t)EdgeStreamFormat::VERSION);
+    put((uint32_t)l);
+    put((uint32_t)Config::N_LIMBS);
+  }
+
+  // Writes j and returns its id
+  uint32_t node(const Fp2T &j) {
+    put(EdgeStreamFormat::TAG_NODE);
+    put(j.c0.val.limbs);
+    put(j.c1.val.limbs);
+    return nodes++;
+  }
+
+  void edge(uint32_t from, uint32_t to) {
+    put(EdgeStreamFormat::TAG_EDGE);
+    put(from);
+    put(to);
+    ++edges;
+  }
+
+  bool good() const { return (bool)os; }
+
+private:
+  std::ostream &os;
+
+  template <typename T> void put(const T &v) {
+    os.write((const char *)&v, sizeof(T));
+    bytes += sizeof(T);
+  }
+};
+
+template <typename Config> class EdgeStreamReader {
+  using Fp2T = Fp2<Config>;
+
+public:
+  int l = 0;
+  std::vector<Fp2T> nodes; // j by id, grows while reading
+
+  // Reads and checks the header; see valid()
+  explicit EdgeStreamReader(std::istream &is) : is(is) {
+    uint32_t magic = 0, version = 0, ell = 0, limbs = 0;
+    ok = get(magic) && get(version) && get(ell) && get(limbs);
+    if (!ok || magic != EdgeStreamFormat::MAGIC ||
+        version != EdgeStreamFormat::VERSION || limbs != Config::N_LIMBS) {
+      std::cerr << "EdgeStreamReader: not an edge stream for this field"
+                << std::endl;
+      ok = false;
+      return;
+    }
+    l = (int)ell;
+  }
+
+  bool valid() const { return ok; }
+
+  // Next edge as (j_from, j_to); false at the end of the stream or on a
+  // malformed record (reported on std::cerr, and valid() turns false)
+  bool next(std::pair<Fp2T, Fp2T> &edge) {
+    while (ok) {
+      uint8_t tag;
+      if (!get(tag))
+        return false; // clean end of stream
+      if (tag == EdgeStreamFormat::TAG_NODE) {
+        Fp2T j;
+        if (!get(j.c0.val.limbs) || !get(j.c1.val.limbs))
+          return fail("truncated node");
+        nodes.push_back(j);
+      } else if (tag == EdgeStreamFormat::TAG_EDGE) {
+        uint32_t from, to;
+        if (!get(from) || !get(to))
+          return fail("truncated edge");
+        if (from >= nodes.size() || to >= nodes.size())
+          return fail("edge to an unknown node");
+        edge = {nodes[from], nodes[to]};
+        return true;
+      } else {
+        return fail("unknown record");
+      }
+    }
+    return false;
+  }
+
+private:
+  std::istream &is;
+  bool ok = false;
+
+  template <typename T> bool get(T &v) {
+    return (bool)is.read((char *)&v, sizeof(T));
+  }
+
+  bool fail(const char *what) {
+    std::cerr << "EdgeStreamReader: " << what << std::endl;
+    ok = false;
+    return false;
+  }
+};
+
+} // namespace crypto
@@ -2,6 +2,8 @@
 
 #include "fp2.hpp"
 #include <iostream>
+#include <span>
+#include <vector>
 
 namespace crypto {
 
@@ -256,6 +258,47 @@ template <typename Config> struct CurveMapper {
     return Q;
   }
 
+  // MontToEdwards / EdwardsToMont for many points: the 2n denominators
+  // (v and u + 1, or 1 - y and x) share one inversion (Montgomery's trick).
+  // Results match the single-point maps, zero denominators included.
+  static bool MontToEdwardsBatch(std::span<const MontPoint> in,
+                                 std::span<EdPoint> out) {
+    if (!same_size(in.size(), out.size()))
+      return false;
+    const size_t n = in.size();
+    Fp2T one = Fp2T::one();
+    std::vector<Fp2T> den(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+      den[2 * i] = in[i].v;
+      den[2 * i + 1] = Fp2T::add(in[i].u, one);
+    }
+    Fp2T::batch_inv(den.data(), den.size());
+    for (size_t i = 0; i < n; ++i) {
+      out[i].X = Fp2T::mul(in[i].u, den[2 * i]);
+      out[i].Y = Fp2T::mul(Fp2T::sub(in[i].u, one), den[2 * i + 1]);
+    }
+    return true;
+  }
+
+  static bool EdwardsToMontBatch(std::span<const EdPoint> in,
+                                 std::span<MontPoint> out) {
+    if (!same_size(in.size(), out.size()))
+      return false;
+    const size_t n = in.size();
+    Fp2T one = Fp2T::one();
+    std::vector<Fp2T> den(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+      den[2 * i] = Fp2T::sub(one, in[i].Y);
+      den[2 * i + 1] = in[i].X;
+    }
+    Fp2T::batch_inv(den.data(), den.size());
+    for (size_t i = 0; i < n; ++i) {
+      out[i].u = Fp2T::mul(Fp2T::add(one, in[i].Y), den[2 * i]);
+      out[i].v = Fp2T::mul(out[i].u, den[2 * i + 1]);
+    }
+    return true;
+  }
+
   // Check if two Montgomery points are equal (x-coord only for simplicity)
   static bool MontPointsEqualX(const MontPoint &P, const MontPoint &Q) {
     for (size_t i = 0; i < Config::N_LIMBS; ++i) {
@@ -266,6 +309,15 @@ template <typename Config> struct CurveMapper {
     }
     return true;
   }
+
+private:
+  static bool same_size(size_t in, size_t out) {
+    if (in == out)
+      return true;
+    std::cerr << "CurveMapper: batch of " << in << " points into " << out
+              << " slots" << std::endl;
+    return false;
+  }
 };
 
 } // namespace crypto
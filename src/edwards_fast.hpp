@@ -1,7 +1,10 @@
 #pragma once
 
 #include "fp2.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <span>
 #include <vector>
 
 namespace crypto {
@@ -40,6 +43,27 @@ template <typename Config> struct EdwardsPointExt {
     y = Fp2T::mul(Y, Z_inv);
   }
 
+  // to_affine for many points with one shared inversion (Montgomery's
+  // trick). Points with Z = 0 come out as (0, 0), as with to_affine.
+  static bool to_affine_batch(std::span<const EdwardsPointExt> pts,
+                              std::span<Fp2T> xs, std::span<Fp2T> ys) {
+    if (xs.size() != pts.size() || ys.size() != pts.size()) {
+      std::cerr << "to_affine_batch: " << pts.size() << " points, "
+                << xs.size() << " x and " << ys.size() << " y slots"
+                << std::endl;
+      return false;
+    }
+    std::vector<Fp2T> z_inv(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i)
+      z_inv[i] = pts[i].Z;
+    Fp2T::batch_inv(z_inv.data(), z_inv.size());
+    for (size_t i = 0; i < pts.size(); ++i) {
+      xs[i] = Fp2T::mul(pts[i].X, z_inv[i]);
+      ys[i] = Fp2T::mul(pts[i].Y, z_inv[i]);
+    }
+    return true;
+  }
+
   // Check if point is identity (Z-normalized check)
   bool is_identity() const {
     // Check if X == 0 and Y == Z (identity is (0:1:1:0))
@@ -177,6 +201,109 @@ public:
     return R;
   }
 
+  // Width-w NAF scalar multiplication (variable time)
+  // k is recoded into digits that are 0 or odd with |d| < 2^(w-1), at most
+  // one nonzero in any w consecutive positions; the table holds the odd
+  // multiples P, 3P, .., (2^(w-1) - 1)P and a negative digit adds the
+  // negated entry (Negate is free). Evaluation is left to right from the top
+  // nonzero digit, so it stops at the bit length of k: about len doublings
+  // and len / (w + 1) additions, against N_LIMBS * 64 doublings and len / 2
+  // additions for ScalarMul. Branches and table indices follow the scalar.
+  static constexpr int WNAF_WIDTH = 5;
+
+  Point ScalarMulWNAF(const Point &P, const BigInt<Config::N_LIMBS> &k,
+                      int w = WNAF_WIDTH) const {
+    w = std::max(2, std::min(w, 8));
+    const size_t len = k.bit_length();
+    if (len == 0)
+      return Point::identity();
+
+    // naf[i] is the digit of 2^i; a final carry lands at position len
+    std::vector<int8_t> naf(len + 1, 0);
+    uint64_t carry = 0;
+    for (size_t bit = 0; bit < len;) {
+      if ((uint64_t)k.get_bit(bit) == carry) {
+        ++bit;
+        continue;
+      }
+      int now = (int)std::min<size_t>(w, len - bit);
+      int64_t word = (int64_t)(k.get_bits(bit, now) + carry);
+      carry = (word >> (w - 1)) & 1;
+      word -= (int64_t)(carry << w);
+      naf[bit] = (int8_t)word;
+      bit += now;
+    }
+    naf[len] = (int8_t)carry;
+
+    std::vector<Point> table = odd_multiples(P, w);
+    auto term = [&](int d) {
+      return d > 0 ? table[(d - 1) / 2] : Negate(table[(-d - 1) / 2]);
+    };
+    size_t top = len;
+    while (naf[top] == 0)
+      --top;
+    Point R = term(naf[top]);
+    for (size_t i = top; i-- > 0;) {
+      R = Double(R);
+      if (naf[i])
+        R = Add(R, term(naf[i]));
+    }
+    return R;
+  }
+
+  Point ScalarMul64WNAF(const Point &P, uint64_t k, int w = 4) const {
+    return ScalarMulWNAF(P, BigInt<Config::N_LIMBS>(k), w);
+  }
+
+  // Width-w signed-window scalar multiplication (constant time)
+  // Regular recoding: every one of the ceil(N_LIMBS * 64 / (w - 1)) digits
+  // is odd, |d| < 2^(w-1) (the same table as ScalarMulWNAF), and is read
+  // straight from bits of k, so the sequence of doublings and additions is
+  // fixed by the scalar width, not its value. Each entry is picked by
+  // scanning the whole table with masked moves and negated by a masked move;
+  // an even k is computed as (k + 1)P - P, the correction selected the same
+  // way. The field arithmetic underneath is assumed branch-free.
+  Point ScalarMulCT(const Point &P, const BigInt<Config::N_LIMBS> &k,
+                    int w = WNAF_WIDTH) const {
+    w = std::max(2, std::min(w, 8));
+    const int s = w - 1;
+    const size_t digits = (Config::N_LIMBS * 64 + s - 1) / s;
+    const uint64_t half = 1ULL << (s - 1);
+    std::vector<Point> table = odd_multiples(P, w);
+
+    // Digit j of k | 1 is 2 b_j + 1 - 2^s with b_j = s bits of k from
+    // j s + 1; the top digit is 2 b + 1 (always positive).
+    auto select = [&](uint64_t idx, uint64_t neg_mask) {
+      Point Q = Point::identity();
+      for (size_t i = 0; i < table.size(); ++i)
+        cmov(Q, table[i], eq_mask(i, idx));
+      cmov(Q, Negate(Q), neg_mask);
+      return Q;
+    };
+
+    Point R = select(k.get_bits((digits - 1) * s + 1, s), 0);
+    for (size_t j = digits - 1; j-- > 0;) {
+      for (int i = 0; i < s; ++i)
+        R = Double(R);
+      uint64_t b = k.get_bits(j * s + 1, s);
+      uint64_t neg_mask = 0 - ((b >> (s - 1)) ^ 1);
+      uint64_t idx = (b ^ (neg_mask & (half - 1))) & (half - 1);
+      R = Add(R, select(idx, neg_mask));
+    }
+
+    Point R_minus_P = Add(R, Negate(P));
+    cmov(R, R_minus_P, 0 - ((k.limbs[0] & 1) ^ 1));
+    return R;
+  }
+
+  // -(x, y) = (-x, y): negate X and T
+  static Point Negate(const Point &P) {
+    Point R = P;
+    R.X = Fp2T::sub(Fp2T::zero(), P.X);
+    R.T = Fp2T::sub(Fp2T::zero(), P.T);
+    return R;
+  }
+
   static void Normalize(Point &P) {
     if (P.Z.is_zero())
       return;
@@ -187,6 +314,25 @@ public:
     P.Z = Fp2T::one();
   }
 
+  // Normalize for many points with one shared inversion (Montgomery's
+  // trick): three multiplications per point instead of an inversion each.
+  // Points with Z = 0 are left alone, as with Normalize.
+  static void NormalizeBatch(std::span<Point> pts) {
+    std::vector<Fp2T> z_inv(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i)
+      z_inv[i] = pts[i].Z;
+    Fp2T::batch_inv(z_inv.data(), z_inv.size());
+    for (size_t i = 0; i < pts.size(); ++i) {
+      Point &P = pts[i];
+      if (P.Z.is_zero())
+        continue;
+      P.X = Fp2T::mul(P.X, z_inv[i]);
+      P.Y = Fp2T::mul(P.Y, z_inv[i]);
+      P.T = Fp2T::mul(P.X, P.Y);
+      P.Z = Fp2T::one();
+    }
+  }
+
   static bool PointsEqual(const Point &P, const Point &Q) {
     Fp2T X1Z2 = Fp2T::mul(P.X, Q.Z);
     Fp2T X2Z1 = Fp2T::mul(Q.X, P.Z);
@@ -194,6 +340,42 @@ public:
     Fp2T Y2Z1 = Fp2T::mul(Q.Y, P.Z);
     return Fp2T::equal(X1Z2, X2Z1) && Fp2T::equal(Y1Z2, Y2Z1);
   }
+
+private:
+  template <typename, int> friend class JointFixedBaseComb;
+
+  // P, 3P, 5P, .., (2^(w-1) - 1)P
+  std::vector<Point> odd_multiples(const Point &P, int w) const {
+    std::vector<Point> table((size_t)1 << (w - 2));
+    table[0] = P;
+    if (table.size() > 1) {
+      Point P2 = Double(P);
+      for (size_t i = 1; i < table.size(); ++i)
+        table[i] = Add(table[i - 1], P2);
+    }
+    return table;
+  }
+
+  // all ones when a == b, else zero, without a branch
+  static uint64_t eq_mask(uint64_t a, uint64_t b) {
+    uint64_t x = a ^ b;
+    return ((x | (0 - x)) >> 63) - 1;
+  }
+
+  // dst <- src where mask is all ones, limb by limb
+  static void cmov(Point &dst, const Point &src, uint64_t mask) {
+    cmov(dst.X, src.X, mask);
+    cmov(dst.Y, src.Y, mask);
+    cmov(dst.Z, src.Z, mask);
+    cmov(dst.T, src.T, mask);
+  }
+
+  static void cmov(Fp2T &dst, const Fp2T &src, uint64_t mask) {
+    for (size_t i = 0; i < Config::N_LIMBS; ++i) {
+      dst.c0.val.limbs[i] ^= mask & (dst.c0.val.limbs[i] ^ src.c0.val.limbs[i]);
+      dst.c1.val.limbs[i] ^= mask & (dst.c1.val.limbs[i] ^ src.c1.val.limbs[i]);
+    }
+  }
 };
 
 // Fixed-Base Comb Optimization Helper
@@ -288,4 +470,107 @@ public:
   }
 };
 
+// Joint fixed-base comb for k P + l Q (two fixed bases, e.g. Pedersen G, H)
+// Both scalars are read as W rows of spacing = ceil(bits / W) bits, as in
+// FixedBaseComb, and one table of 2^(2W) entries holds every sum of the
+// basis points 2^(j spacing) P and 2^(j spacing) Q; entry a + 2^W b picks
+// the P rows in a and the Q rows in b. Each column is then one doubling and
+// one addition for both scalars: bits / W of each, against bits doublings
+// and up to bits additions per scalar for double-and-add.
+// table[0] is the identity and the unified addition handles it, so every
+// column adds the same way whatever the scalar bits. Mul still indexes the
+// table with scalar bits, so its memory accesses leak them; MulCT reads
+// every entry with masked moves instead (as ScalarMulCT does), which costs
+// a scan of the whole table per column.
+template <typename Config, int W> class JointFixedBaseComb {
+  static_assert(W >= 1 && W <= 8, "JointFixedBaseComb: W in 1..8");
+  using Curve = TwistedEdwardsFast<Config>;
+  using Point = typename Curve::Point;
+  using Scalar = BigInt<Config::N_LIMBS>;
+
+  Curve curve;
+  std::vector<Point> table; // 2^(2W) entries
+  int bits;
+  int spacing;
+
+public:
+  // Only the low `bits` bits of the scalars are read
+  JointFixedBaseComb(const Curve &c, const Point &P, const Point &Q,
+                     int bits = Config::N_LIMBS * 64)
+      : curve(c), bits(bits), spacing((bits + W - 1) / W) {
+    // basis[j] = 2^(j spacing) P, basis[W + j] = 2^(j spacing) Q
+    std::vector<Point> basis(2 * W);
+    basis[0] = P;
+    basis[W] = Q;
+    for (int j = 1; j < W; ++j) {
+      basis[j] = basis[j - 1];
+      basis[W + j] = basis[W + j - 1];
+      for (int k = 0; k < spacing; ++k) {
+        basis[j] = curve.Double(basis[j]);
+        basis[W + j] = curve.Double(basis[W + j]);
+      }
+    }
+
+    // Each entry is an earlier one plus the basis point of its lowest bit
+    table.resize((size_t)1 << (2 * W));
+    table[0] = Point::identity();
+    for (size_t idx = 1; idx < table.size(); ++idx) {
+      int low = 0;
+      while (!((idx >> low) & 1))
+        ++low;
+      table[idx] = curve.Add(table[idx & (idx - 1)], basis[low]);
+    }
+  }
+
+  size_t table_size() const { return table.size(); }
+
+  Point Mul(const Scalar &k, const Scalar &l) const {
+    return mul([&](int pos) { return k.get_bit((size_t)pos); },
+               [&](int pos) { return l.get_bit((size_t)pos); });
+  }
+
+  Point Mul(uint64_t k, uint64_t l) const {
+    return mul([&](int pos) { return pos < 64 && ((k >> pos) & 1); },
+               [&](int pos) { return pos < 64 && ((l >> pos) & 1); });
+  }
+
+  // Mul with a constant-time table lookup, for secret scalars
+  Point MulCT(const Scalar &k, const Scalar &l) const {
+    return mul<true>([&](int pos) { return k.get_bit((size_t)pos); },
+                     [&](int pos) { return l.get_bit((size_t)pos); });
+  }
+
+  Point MulCT(uint64_t k, uint64_t l) const {
+    return mul<true>([&](int pos) { return pos < 64 && ((k >> pos) & 1); },
+                     [&](int pos) { return pos < 64 && ((l >> pos) & 1); });
+  }
+
+private:
+  // pos only depends on the column, never on the scalars
+  template <bool CT = false, typename BitK, typename BitL>
+  Point mul(BitK &&bit_k, BitL &&bit_l) const {
+    Point R = Point::identity();
+    for (int i = spacing - 1; i >= 0; --i) {
+      R = curve.Double(R);
+      size_t index = 0;
+      for (int j = 0; j < W; ++j) {
+        int pos = i + j * spacing;
+        if (pos >= bits)
+          break;
+        index |= (size_t)bit_k(pos) << j;
+        index |= (size_t)bit_l(pos) << (W + j);
+      }
+      if (CT) {
+        Point T = Point::identity();
+        for (size_t e = 0; e < table.size(); ++e)
+          Curve::cmov(T, table[e], Curve::eq_mask(e, index));
+        R = curve.Add(R, T);
+      } else {
+        R = curve.Add(R, table[index]);
+      }
+    }
+    return R;
+  }
+};
+
 } // namespace crypto
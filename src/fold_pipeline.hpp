@@ -0,0 +1,245 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "cross_terms.hpp"
+#include "phi_cache.hpp"
+#include "relaxed_folding.hpp"
+#include "spsc_ring.hpp"
+#include "transcript.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+// The fold_edges loop split into four threads connected by SpscRings:
+//
+//   generate  next edge -> fresh witness, checked to be an edge
+//   commit    hash commitment of the witness (its own Transcript digest)
+//   fold      cross terms against the accumulator, absorb (commitment, T),
+//             squeeze r, fold
+//   verify    Phi(acc) = u for every accumulator the fold stage produces
+//
+// The transcript stays in the fold stage: r has to bind the cross terms and
+// those depend on the previous accumulator, so nothing past the commitment
+// can run ahead of the fold. Checking each new accumulator (a cache miss,
+// every j is new) is what moves off the critical path. Each stage owns its
+// PhiSpecializationCache, so nothing is shared but the rings.
+//
+// Rings are bounded: a stage that gets ahead blocks (backpressure) and the
+// throughput is set by the slowest stage. run() and run_serial() absorb,
+// squeeze and fold in the same order, so their accumulators are identical.
+template <typename Config> class FoldPipeline {
+  using Fp2T = Fp2<Config>;
+  using Folder = RelaxedIsogenyFolder<Config>;
+  using Engine = CrossTermEngine<Config>;
+  using TranscriptT = Transcript<Config>;
+
+public:
+  using Witness = typename Folder::RelaxedWitness;
+  using Digest = typename TranscriptT::Digest;
+
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+  static constexpr size_t STAGES = 4;
+  static constexpr const char *STAGE_NAMES[STAGES] = {"generate", "commit",
+                                                      "fold", "verify"};
+
+  struct StageStats {
+    uint64_t items = 0;
+    double busy_ms = 0;        // time spent working, waits excluded
+    uint64_t in_stalls = 0;    // pops that found the input ring empty
+    uint64_t out_stalls = 0;   // pushes that found the output ring full
+    double in_occupancy = 0;   // mean input ring fill level seen by pops
+  };
+
+  struct Result {
+    Witness acc;
+    bool ok = false;
+    uint64_t folded = 0;
+    double seconds = 0;
+    std::array<StageStats, STAGES> stages;
+  };
+
+  BivariatePoly<Fp2T> phi;
+  Engine engine;
+  size_t capacity;
+
+  explicit FoldPipeline(const BivariatePoly<Fp2T> &phi,
+                        size_t capacity = DEFAULT_CAPACITY)
+      : phi(phi), engine(phi), capacity(capacity) {}
+
+  // Folds up to max_folds edges from next_edge (called on the generate
+  // thread only) into an accumulator seeded by first
+  template <typename NextEdge>
+  Result run(const std::pair<Fp2T, Fp2T> &first, NextEdge &&next_edge,
+             uint64_t max_folds) const {
+    struct Committed {
+      Witness w;
+      Digest d;
+    };
+    SpscRing<Witness> fresh(capacity);
+    SpscRing<Committed> committed(capacity);
+    SpscRing<Witness> folded(capacity);
+
+    Result res;
+    std::atomic<bool> failed{false};
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+      return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    auto t_start = Clock::now();
+
+    std::thread generate([&]() {
+      PhiSpecializationCache<Config> cache(phi);
+      StageStats &st = res.stages[0];
+      std::pair<Fp2T, Fp2T> e;
+      while (st.items < max_folds && !failed.load(std::memory_order_relaxed)) {
+        auto t0 = Clock::now();
+        if (!next_edge(e))
+          break;
+        Witness w = {e.first, e.second, Fp2T::zero()};
+        bool edge = Folder::verify(cache, w);
+        st.busy_ms += ms(t0, Clock::now());
+        if (!edge) {
+          std::cerr << "FoldPipeline: witness " << st.items
+                    << " is not an edge" << std::endl;
+          failed = true;
+          break;
+        }
+        fresh.push(w);
+        ++st.items;
+      }
+      fresh.close();
+    });
+
+    std::thread commit([&]() {
+      StageStats &st = res.stages[1];
+      Witness w;
+      while (fresh.pop(w)) {
+        auto t0 = Clock::now();
+        Committed c{w, commitment(w)};
+        st.busy_ms += ms(t0, Clock::now());
+        committed.push(std::move(c));
+        ++st.items;
+      }
+      committed.close();
+    });
+
+    std::thread fold([&]() {
+      StageStats &st = res.stages[2];
+      Witness acc = {first.first, first.second, Fp2T::zero()};
+      TranscriptT transcript;
+      transcript.Absorb(acc);
+      Committed c;
+      while (committed.pop(c)) {
+        auto t0 = Clock::now();
+        acc = step(transcript, acc, c.w, c.d);
+        st.busy_ms += ms(t0, Clock::now());
+        folded.push(acc);
+        ++st.items;
+      }
+      res.acc = acc;
+      folded.close();
+    });
+
+    // verify runs on the calling thread
+    {
+      PhiSpecializationCache<Config> cache(phi);
+      StageStats &st = res.stages[3];
+      Witness acc;
+      while (folded.pop(acc)) {
+        auto t0 = Clock::now();
+        bool ok = failed.load(std::memory_order_relaxed) ||
+                  Folder::verify(cache, acc);
+        st.busy_ms += ms(t0, Clock::now());
+        if (!ok) {
+          std::cerr << "FoldPipeline: accumulator " << st.items
+                    << " fails verification" << std::endl;
+          failed = true; // generate stops, the rest drains
+        }
+        ++st.items;
+      }
+    }
+    generate.join();
+    commit.join();
+    fold.join();
+
+    res.seconds =
+        std::chrono::duration<double>(Clock::now() - t_start).count();
+    res.folded = res.stages[3].items;
+    res.ok = !failed.load();
+
+    res.stages[0].out_stalls = fresh.full_stalls();
+    res.stages[1].in_stalls = fresh.empty_stalls();
+    res.stages[1].in_occupancy = fresh.mean_occupancy();
+    res.stages[1].out_stalls = committed.full_stalls();
+    res.stages[2].in_stalls = committed.empty_stalls();
+    res.stages[2].in_occupancy = committed.mean_occupancy();
+    res.stages[2].out_stalls = folded.full_stalls();
+    res.stages[3].in_stalls = folded.empty_stalls();
+    res.stages[3].in_occupancy = folded.mean_occupancy();
+    return res;
+  }
+
+  // The same four steps in one loop on the calling thread
+  template <typename NextEdge>
+  Result run_serial(const std::pair<Fp2T, Fp2T> &first, NextEdge &&next_edge,
+                    uint64_t max_folds) const {
+    PhiSpecializationCache<Config> edge_cache(phi), acc_cache(phi);
+    Result res;
+    auto t0 = std::chrono::steady_clock::now();
+    Witness acc = {first.first, first.second, Fp2T::zero()};
+    TranscriptT transcript;
+    transcript.Absorb(acc);
+    res.ok = true;
+    std::pair<Fp2T, Fp2T> e;
+    while (res.folded < max_folds && next_edge(e)) {
+      Witness w = {e.first, e.second, Fp2T::zero()};
+      if (!Folder::verify(edge_cache, w)) {
+        std::cerr << "FoldPipeline: witness " << res.folded
+                  << " is not an edge" << std::endl;
+        res.ok = false;
+        break;
+      }
+      acc = step(transcript, acc, w, commitment(w));
+      if (!Folder::verify(acc_cache, acc)) {
+        std::cerr << "FoldPipeline: accumulator " << res.folded
+                  << " fails verification" << std::endl;
+        res.ok = false;
+        break;
+      }
+      ++res.folded;
+    }
+    res.acc = acc;
+    res.seconds = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - t0)
+                      .count();
+    return res;
+  }
+
+private:
+  static Digest commitment(const Witness &w) {
+    TranscriptT t;
+    t.Absorb(w);
+    return t.SqueezeDigest();
+  }
+
+  Witness step(TranscriptT &transcript, const Witness &acc, const Witness &w,
+               const Digest &d) const {
+    auto T = engine.cross_terms(acc, w);
+    transcript.Absorb(d);
+    transcript.Absorb(T);
+    Fp2T r = transcript.Squeeze();
+    if (r.c0.val.limbs[0] == 0 && r.c1.val.limbs[0] == 0) {
+      r.c0.val.limbs[0] = 1;
+    }
+    return Engine::fold(acc, w, T, r);
+  }
+};
+
+} // namespace crypto
@@ -2,6 +2,8 @@
 
 #include "curve.hpp"
 #include "isogeny.hpp"
+#include <random>
+#include <vector>
 
 namespace crypto {
 
@@ -19,17 +21,36 @@ public:
   };
 
   // BatchFold: P_new = w1.P + [r]w2.P, Q_new = w1.Q + [r]w2.Q
+  // [r]w2.P and [r]w2.Q share one window schedule (multi_scalar_mul), and w1
+  // rides along as a point with scalar 1.
   static Witness BatchFold(const Witness &w1, const Witness &w2,
                            const BigIntT &r, const Fp2T &A) {
-    // scalar mul w2.P
-    FullPoint rP2 = Curve::scalar_mul(w2.P, r, A);
-    FullPoint rQ2 = Curve::scalar_mul(w2.Q, r, A);
+    return BatchFoldMany(w1, std::vector<Witness>{w2}, std::vector<BigIntT>{r},
+                         A);
+  }
 
-    // Add to w1
-    FullPoint P_new = Curve::add_affine(w1.P, rP2, A);
-    FullPoint Q_new = Curve::add_affine(w1.Q, rQ2, A);
+  // P_new = acc.P + sum_i [r_i] ws[i].P, same for Q: two Straus sums over
+  // one doubling schedule, one inversion at the end
+  static Witness BatchFoldMany(const Witness &acc,
+                               const std::vector<Witness> &ws,
+                               const std::vector<BigIntT> &rs,
+                               const Fp2T &A) {
+    std::vector<std::vector<FullPoint>> sums(2);
+    sums[0].reserve(ws.size() + 1);
+    sums[1].reserve(ws.size() + 1);
+    sums[0].push_back(acc.P);
+    sums[1].push_back(acc.Q);
+    for (const Witness &w : ws) {
+      sums[0].push_back(w.P);
+      sums[1].push_back(w.Q);
+    }
+    std::vector<BigIntT> ks;
+    ks.reserve(rs.size() + 1);
+    ks.push_back(BigIntT(1));
+    ks.insert(ks.end(), rs.begin(), rs.end());
 
-    return Witness{P_new, Q_new};
+    auto out = Curve::multi_scalar_mul(sums, ks, A);
+    return Witness{out[0], out[1]};
   }
 
   template <typename VeluT>
@@ -59,6 +80,55 @@ public:
     }
     return true;
   }
+
+  // Heuristic batch check of phi(ws[i].P) == ws[i].Q with one isogeny
+  // evaluation: phi is a homomorphism, so with random 64-bit rho_i an honest
+  // batch satisfies
+  //   phi(sum rho_i P_i) == sum rho_i Q_i
+  // (compared x-only, like above). Both sums come from one multi_scalar_mul
+  // call.
+  //
+  // This is not a 2^-64 test. A bad witness Q_i = phi(P_i) + T_i only
+  // escapes if sum rho_i T_i = O, and E(Fp2) = (Z/(p+1))^2 is entirely smooth
+  // for SIDH-style primes (p + 1 = 2^216 3^137 for p434): an error T_i of
+  // order 2 or 3 slips through with probability 1/2 or 1/3. Treat a pass as
+  // evidence, not proof, and use the single-witness check where soundness
+  // matters.
+  //
+  // Signs are not per witness either: the sums use the full points, so the
+  // batch expects Q_i = phi(P_i) exactly (up to one sign for the whole sum).
+  // Witnesses that each pass the x-only check above, but with mixed signs,
+  // are rejected.
+  template <typename VeluT>
+  static bool VerifyBatch(const std::vector<Witness> &ws, const VeluT &phi,
+                          const Fp2T &A, uint64_t seed) {
+    if (ws.empty())
+      return true;
+    std::mt19937_64 rng(seed);
+    std::vector<std::vector<FullPoint>> sums(2);
+    std::vector<BigIntT> rho(ws.size());
+    for (size_t i = 0; i < ws.size(); ++i) {
+      sums[0].push_back(ws[i].P);
+      sums[1].push_back(ws[i].Q);
+      rho[i] = BigIntT(rng());
+    }
+    auto out = Curve::multi_scalar_mul(sums, rho, A);
+    if (out[0].Z.is_zero())
+      return out[1].Z.is_zero();
+    if (out[1].Z.is_zero()) {
+      // the projective check below cannot see an infinite Q
+      PointProj S{out[0].X, out[0].Z};
+      phi.Eval(S);
+      return S.Z.is_zero();
+    }
+    return VerifyBatch(Witness{out[0], out[1]}, phi);
+  }
+
+  template <typename VeluT>
+  static bool VerifyBatch(const std::vector<Witness> &ws, const VeluT &phi,
+                          const Fp2T &A) {
+    return VerifyBatch(ws, phi, A, std::random_device{}());
+  }
 };
 
 } // namespace crypto
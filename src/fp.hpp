@@ -192,7 +192,7 @@ public:
     return pow(a, p);
   }
 
-  void print() const { val.print(); }
+  void print(std::ostream &os = std::cout) const { val.print(os); }
 };
 
 } // namespace crypto
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fp.hpp"
+#include <vector>
 
 namespace crypto {
 
@@ -30,6 +31,18 @@ template <typename P> struct Fp2 {
     return true;
   }
 
+  // 64-bit hash of the limbs for hash tables keyed by field elements.
+  // Limbs are canonical (< p), so equal elements hash equally.
+  static uint64_t hash(const Fp2 &a) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < P::N_LIMBS; ++i) {
+      h = (h ^ a.c0.val.limbs[i]) * 0xFF51AFD7ED558CCDULL;
+      h = (h ^ a.c1.val.limbs[i]) * 0xC4CEB9FE1A85EC53ULL;
+      h ^= h >> 32;
+    }
+    return h;
+  }
+
   static Fp2 add(const Fp2 &a, const Fp2 &b) {
     return Fp2(FpT::add(a.c0, b.c0), FpT::add(a.c1, b.c1));
   }
@@ -95,6 +108,57 @@ template <typename P> struct Fp2 {
     return Fp2(real, imag);
   }
 
+  // Frobenius a -> a^p, i.e. complex conjugation (i^p = -i for p = 3 mod 4)
+  static Fp2 conj(const Fp2 &a) {
+    return Fp2(a.c0, FpT::sub(FpT::zero(), a.c1));
+  }
+
+  // Left-to-right square-and-multiply; the exponent may be wider than p
+  // (e.g. a divisor of p^2 - 1).
+  template <size_t M> static Fp2 pow(const Fp2 &base, const BigInt<M> &exp) {
+    Fp2 res = one();
+    for (int i = (int)exp.bit_length() - 1; i >= 0; --i) {
+      res = sqr(res);
+      if (exp.get_bit(i))
+        res = mul(res, base);
+    }
+    return res;
+  }
+
+  // Quadratic residuosity: u is a square in Fp2 iff its norm u0^2 + u1^2 is a
+  // square in Fp (Legendre symbol via Euler's criterion).
+  static bool is_square(const Fp2 &u) {
+    FpT norm = FpT::add(FpT::sqr(u.c0), FpT::sqr(u.c1));
+    if (norm.data().is_zero())
+      return true;
+    BigInt<P::N_LIMBS> e = P::p();
+    BigInt<P::N_LIMBS>::div_word(e, 2); // (p-1)/2 since p is odd
+    FpT chi = FpT::pow(norm, e);
+    return Fp2::equal(Fp2(chi, FpT::zero()), one());
+  }
+
+  // Montgomery's trick: invert n elements in place with one inversion.
+  // Zero entries are left as zero.
+  static void batch_inv(Fp2 *vals, size_t n) {
+    if (n == 0)
+      return;
+    std::vector<Fp2> prefix(n);
+    Fp2 acc = one();
+    for (size_t i = 0; i < n; ++i) {
+      prefix[i] = acc;
+      if (!vals[i].is_zero())
+        acc = mul(acc, vals[i]);
+    }
+    Fp2 inv_acc = inv(acc);
+    for (size_t i = n; i-- > 0;) {
+      if (vals[i].is_zero())
+        continue;
+      Fp2 v = vals[i];
+      vals[i] = mul(inv_acc, prefix[i]);
+      inv_acc = mul(inv_acc, v);
+    }
+  }
+
   static Fp2 sqrt(const Fp2 &u) {
     // Special case for Real input (u1 == 0) to avoid failures in generic
     // formula
@@ -187,12 +251,23 @@ template <typename P> struct Fp2 {
     return Fp2(x, y);
   }
 
-  void print() const {
-    std::cout << "(";
-    c0.print();
-    std::cout << " + ";
-    c1.print();
-    std::cout << "*i)";
+  void print(std::ostream &os = std::cout) const {
+    os << "(";
+    c0.print(os);
+    os << " + ";
+    c1.print(os);
+    os << "*i)";
+  }
+};
+
+// Hash / equality functors for std::unordered_* containers keyed by Fp2
+template <typename P> struct Fp2Hash {
+  size_t operator()(const Fp2<P> &a) const { return (size_t)Fp2<P>::hash(a); }
+};
+
+template <typename P> struct Fp2Equal {
+  bool operator()(const Fp2<P> &a, const Fp2<P> &b) const {
+    return Fp2<P>::equal(a, b);
   }
 };
 
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "fp2.hpp"
+
+// Number of independent field elements processed together by the lane engine.
+// 1 selects the plain scalar path.
+#ifndef QHALO_FIELD_LANES
+#define QHALO_FIELD_LANES 4
+#endif
+
+namespace crypto {
+
+// Multi-lane Fp2 engine
+// Operates on L independent elements laid out contiguously (one lane per
+// element). Each primitive issues the same operation for every lane back to
+// back, so the Montgomery reductions of different lanes have no data
+// dependency on each other and overlap in the pipeline. Callers keep their
+// data in structure-of-arrays form and hand the engine one chunk of L lanes
+// at a time.
+template <typename Config, size_t L> struct Fp2Lanes {
+  using Fp2T = Fp2<Config>;
+  static constexpr size_t LANES = L;
+
+  FORCE_INLINE static void add(Fp2T *r, const Fp2T *a, const Fp2T *b) {
+    for (size_t k = 0; k < L; ++k)
+      r[k] = Fp2T::add(a[k], b[k]);
+  }
+
+  FORCE_INLINE static void sub(Fp2T *r, const Fp2T *a, const Fp2T *b) {
+    for (size_t k = 0; k < L; ++k)
+      r[k] = Fp2T::sub(a[k], b[k]);
+  }
+
+  FORCE_INLINE static void mul(Fp2T *r, const Fp2T *a, const Fp2T *b) {
+    for (size_t k = 0; k < L; ++k)
+      r[k] = Fp2T::mul(a[k], b[k]);
+  }
+
+  // Multiply every lane by the same (broadcast) element
+  FORCE_INLINE static void mul_scalar(Fp2T *r, const Fp2T *a, const Fp2T &b) {
+    for (size_t k = 0; k < L; ++k)
+      r[k] = Fp2T::mul(a[k], b);
+  }
+
+  FORCE_INLINE static void sqr(Fp2T *r, const Fp2T *a) {
+    for (size_t k = 0; k < L; ++k)
+      r[k] = Fp2T::sqr(a[k]);
+  }
+};
+
+} // namespace crypto
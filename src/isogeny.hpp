@@ -1,9 +1,39 @@
 #pragma once
 
 #include "curve.hpp"
+#include "fp2_lanes.hpp"
+#include <span>
+#include <vector>
 
 namespace crypto {
 
+// Structure-of-arrays buffer of x-only projective points
+// Keeps all X coordinates and all Z coordinates contiguous so that batched
+// isogeny evaluation can stream them through the lane engine.
+template <typename Config> struct PointBatch {
+  using Fp2T = Fp2<Config>;
+  using Point = PointProj<Config>;
+
+  std::vector<Fp2T> X, Z;
+
+  PointBatch() {}
+  PointBatch(std::span<const Point> pts) {
+    X.reserve(pts.size());
+    Z.reserve(pts.size());
+    for (const auto &P : pts)
+      push_back(P);
+  }
+
+  size_t size() const { return X.size(); }
+
+  void push_back(const Point &P) {
+    X.push_back(P.X);
+    Z.push_back(P.Z);
+  }
+
+  Point get(size_t i) const { return Point{X[i], Z[i]}; }
+};
+
 template <typename Config> class Isogeny {
 public:
   using Point = PointProj<Config>;
@@ -80,16 +110,117 @@ public:
 
   // 3-Isogeny wrapping
   struct Iso3Result {
-    Fp2T A_prime, C_prime;
-    Fp2T K_X, K_Z;
+    Fp2T A_prime, C_prime; // Codomain (A' : C')
+    Fp2T C0, C1;           // Evaluation constants: K.X - K.Z, K.X + K.Z
   };
 
+  // 3-Isogeny Compute: K is order 3 (SIKE get_3_isog).
   static void Compute3Iso(Iso3Result &res, const Point &K) {
-    // ...
+    res.C0 = Fp2T::sub(K.X, K.Z);
+    res.C1 = Fp2T::add(K.X, K.Z);
+    Fp2T t0 = Fp2T::sqr(res.C0);
+    Fp2T t1 = Fp2T::sqr(res.C1);
+    Fp2T t2 = Fp2T::add(t0, t1);
+    Fp2T t3 = Fp2T::sqr(Fp2T::add(res.C0, res.C1)); // 4X^2
+    t3 = Fp2T::sub(t3, t2);
+    t2 = Fp2T::add(t1, t3);
+    t3 = Fp2T::add(t3, t0);
+    Fp2T t4 = Fp2T::add(t0, t3);
+    t4 = Fp2T::add(t4, t4);
+    t4 = Fp2T::add(t1, t4);
+    Fp2T A24minus = Fp2T::mul(t2, t4); // A' - 2C'
+    t4 = Fp2T::add(t1, t2);
+    t4 = Fp2T::add(t4, t4);
+    t4 = Fp2T::add(t0, t4);
+    Fp2T A24plus = Fp2T::mul(t3, t4); // A' + 2C'
+
+    // (A' : C') = (2(A24+ + A24-) : A24+ - A24-)
+    res.A_prime = Fp2T::add(A24plus, A24minus);
+    res.A_prime = Fp2T::add(res.A_prime, res.A_prime);
+    res.C_prime = Fp2T::sub(A24plus, A24minus);
   }
 
+  // Eval 3-iso at R(X,Z): 4 muls, 2 sqrs (SIKE eval_3_isog)
   static void Eval3Iso(Point &R, const Iso3Result &iso) {
-    // ...
+    Fp2T t0 = Fp2T::add(R.X, R.Z);
+    Fp2T t1 = Fp2T::sub(R.X, R.Z);
+    t0 = Fp2T::mul(iso.C0, t0);
+    t1 = Fp2T::mul(iso.C1, t1);
+    Fp2T t2 = Fp2T::add(t0, t1);
+    t0 = Fp2T::sub(t1, t0);
+    t2 = Fp2T::sqr(t2);
+    t0 = Fp2T::sqr(t0);
+    R.X = Fp2T::mul(R.X, t2);
+    R.Z = Fp2T::mul(R.Z, t0);
+  }
+
+  // ---------------------------------------------------------------------
+  // Batched evaluation
+  // ---------------------------------------------------------------------
+  // A chain step pushes several points (P, Q, P-Q and the remaining kernel
+  // multiples) through the same isogeny. The per-isogeny constants are
+  // computed once by Compute*Iso and shared by every point. The SoA variants
+  // walk the X and Z arrays QHALO_FIELD_LANES points at a time through the
+  // lane engine; the span variants are the scalar loop over an AoS buffer.
+
+  static void Eval4IsoBatch(std::span<Point> pts, const Iso4Result &iso) {
+    for (auto &P : pts)
+      Eval4Iso(P, iso);
+  }
+
+  static void Eval3IsoBatch(std::span<Point> pts, const Iso3Result &iso) {
+    for (auto &P : pts)
+      Eval3Iso(P, iso);
+  }
+
+  static void Eval4IsoSoA(Fp2T *X, Fp2T *Z, size_t n, const Iso4Result &iso) {
+    using Lanes = Fp2Lanes<Config, QHALO_FIELD_LANES>;
+    constexpr size_t L = Lanes::LANES;
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+      Fp2T t0[L], t1[L], a[L], b[L];
+      Lanes::add(t0, X + i, Z + i);
+      Lanes::sub(t1, X + i, Z + i);
+      Lanes::mul_scalar(a, t0, iso.C0);
+      Lanes::mul_scalar(b, t1, iso.C1);
+      Lanes::add(t0, a, b); // C
+      Lanes::sub(t1, a, b); // D
+      Lanes::mul(t0, X + i, t0);
+      Lanes::mul(t1, Z + i, t1);
+      Lanes::sqr(X + i, t0);
+      Lanes::sqr(Z + i, t1);
+    }
+    for (; i < n; ++i) {
+      Point P{X[i], Z[i]};
+      Eval4Iso(P, iso);
+      X[i] = P.X;
+      Z[i] = P.Z;
+    }
+  }
+
+  static void Eval3IsoSoA(Fp2T *X, Fp2T *Z, size_t n, const Iso3Result &iso) {
+    using Lanes = Fp2Lanes<Config, QHALO_FIELD_LANES>;
+    constexpr size_t L = Lanes::LANES;
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+      Fp2T t0[L], t1[L], t2[L];
+      Lanes::add(t0, X + i, Z + i);
+      Lanes::sub(t1, X + i, Z + i);
+      Lanes::mul_scalar(t0, t0, iso.C0);
+      Lanes::mul_scalar(t1, t1, iso.C1);
+      Lanes::add(t2, t0, t1);
+      Lanes::sub(t0, t1, t0);
+      Lanes::sqr(t2, t2);
+      Lanes::sqr(t0, t0);
+      Lanes::mul(X + i, X + i, t2);
+      Lanes::mul(Z + i, Z + i, t0);
+    }
+    for (; i < n; ++i) {
+      Point P{X[i], Z[i]};
+      Eval3Iso(P, iso);
+      X[i] = P.X;
+      Z[i] = P.Z;
+    }
   }
 
   // 2-Isogeny: Kernel K order 2.
@@ -111,6 +242,18 @@ public:
     return {A_out, C_out};
   }
 
+  // 2-Isogeny with kernel (0:1), on an affine curve (A, 1).
+  // The formula above degenerates to A' = 2 (singular) for X = 0, so this
+  // kernel needs its own codomain: A' = -2A / sqrt(A^2 - 4).
+  // The sign of the square root only flips A' and does not change j.
+  static std::pair<Fp2T, Fp2T> Compute2IsoCurveZero(const Fp2T &A) {
+    Fp2T four;
+    four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
+    Fp2T C_out = Fp2T::sqrt(Fp2T::sub(Fp2T::sqr(A), four));
+    Fp2T A_out = Fp2T::sub(Fp2T::zero(), Fp2T::add(A, A));
+    return {A_out, C_out};
+  }
+
   // 3-Isogeny: Kernel K order 3.
   static std::pair<Fp2T, Fp2T> Compute3IsoCurve(const Point &K, const Fp2T &A,
                                                 const Fp2T &C) {
@@ -132,7 +275,10 @@ public:
     Fp2T A_out = Fp2T::sub(T1, T3);
     A_out = Fp2T::add(A_out, T4);
 
-    Fp2T C_out = Fp2T::mul(C, XZ);
+    // A' = (A x - 6x^2 + 6) x in affine terms, so the numerator picks up
+    // one more factor X and the denominator is C Z^3.
+    A_out = Fp2T::mul(A_out, K.X);
+    Fp2T C_out = Fp2T::mul(C, Fp2T::mul(Z2, K.Z));
 
     return {A_out, C_out};
   }
@@ -173,12 +319,35 @@ public:
       // formulas. I will write the structure and placeholders for formulas if I
       // can't recall them exactly, but I should try to derive or use standard
       // ones.
+    } else if (ord == 3) {
+      Isogeny<Config>::Compute3Iso(iso3, K);
     }
   }
 
   void Eval(Point &P_in) const { // const
     if (order == 4) {
       Isogeny<Config>::Eval4Iso(P_in, iso4);
+    } else if (order == 3) {
+      Isogeny<Config>::Eval3Iso(P_in, iso3);
+    }
+  }
+
+  // Push several points through the same isogeny, sharing the precomputation
+  void EvalBatch(std::span<Point> pts) const {
+    if (order == 4) {
+      Isogeny<Config>::Eval4IsoBatch(pts, iso4);
+    } else if (order == 3) {
+      Isogeny<Config>::Eval3IsoBatch(pts, iso3);
+    }
+  }
+
+  void EvalBatch(PointBatch<Config> &pts) const {
+    if (order == 4) {
+      Isogeny<Config>::Eval4IsoSoA(pts.X.data(), pts.Z.data(), pts.size(),
+                                   iso4);
+    } else if (order == 3) {
+      Isogeny<Config>::Eval3IsoSoA(pts.X.data(), pts.Z.data(), pts.size(),
+                                   iso3);
     }
   }
 };
@@ -191,6 +360,19 @@ FORCE_INLINE void EvaluateIsogeny(PointProj<Config> &P,
   velu.Eval(P);
 }
 
+// Batched counterparts of EvaluateIsogeny(): AoS span or SoA buffer
+template <typename Config>
+FORCE_INLINE void EvaluateIsogeny(std::span<PointProj<Config>> pts,
+                                  const Velu<Config> &velu) {
+  velu.EvalBatch(pts);
+}
+
+template <typename Config>
+FORCE_INLINE void EvaluateIsogeny(PointBatch<Config> &pts,
+                                  const Velu<Config> &velu) {
+  velu.EvalBatch(pts);
+}
+
 // Explicit Implementation of formulas
 
 // 2-ISO
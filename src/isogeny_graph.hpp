@@ -0,0 +1,218 @@
+#pragma once
+
+#include "curve.hpp"
+#include "edge_stream.hpp"
+#include "fp2.hpp"
+#include "modpoly.hpp"
+#include "thread_pool.hpp"
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace crypto {
+
+// Hash map keyed by Fp2 that many threads can update at once
+// Keys are spread over SHARDS independently locked tables by the top bits of
+// Fp2::hash, so threads interning different j rarely touch the same lock.
+template <typename Config, typename V> class ConcurrentFp2Map {
+  using Fp2T = Fp2<Config>;
+
+public:
+  static constexpr size_t SHARDS = 64;
+
+  // Inserts (k, v), or replaces the stored value w by merge(w, v).
+  // Returns true if k was new.
+  template <typename Merge>
+  bool upsert(const Fp2T &k, const V &v, Merge &&merge) {
+    Shard &s = shard(k);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto it = s.map.find(k);
+    if (it == s.map.end()) {
+      s.map.emplace(k, v);
+      return true;
+    }
+    it->second = merge(it->second, v);
+    return false;
+  }
+
+  bool find(const Fp2T &k, V &out) {
+    Shard &s = shard(k);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto it = s.map.find(k);
+    if (it == s.map.end())
+      return false;
+    out = it->second;
+    return true;
+  }
+
+  void assign(const Fp2T &k, const V &v) {
+    Shard &s = shard(k);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.map[k] = v;
+  }
+
+  size_t size() {
+    size_t n = 0;
+    for (auto &s : shards) {
+      std::lock_guard<std::mutex> lock(s.mtx);
+      n += s.map.size();
+    }
+    return n;
+  }
+
+private:
+  struct alignas(64) Shard {
+    std::mutex mtx;
+    std::unordered_map<Fp2T, V, Fp2Hash<Config>, Fp2Equal<Config>> map;
+  };
+  std::array<Shard, SHARDS> shards;
+
+  Shard &shard(const Fp2T &k) { return shards[Fp2T::hash(k) >> 58]; }
+};
+
+// Breadth-first exploration of the supersingular l-isogeny graph (l = 2, 3)
+// Nodes are j-invariants, each represented by one Montgomery A; edges come
+// from ModularPolynomialGenerator::neighbor_curves and satisfy
+// Phi_l(j, j') = 0, so every edge is a valid fresh witness for folding.
+//
+// Each BFS level runs in two phases:
+//   1. Parallel: every frontier node computes its neighbours and claims
+//      them in a ConcurrentFp2Map, keeping the smallest (level, position)
+//      claim per j. This is where all the field arithmetic happens.
+//   2. Serial, in frontier order: the j whose winning claim is its own
+//      position become new nodes (ids, NODE records, next frontier), then
+//      every frontier node writes its EDGE records.
+// Claims depend only on positions, not on thread timing, so the stream is
+// byte-identical for every pool size.
+template <typename Config> class IsogenyGraphExplorer {
+  using Fp2T = Fp2<Config>;
+  using Curve = MontgomeryCurve<Config>;
+  using Gen = ModularPolynomialGenerator<Config>;
+
+public:
+  struct Stats {
+    size_t levels = 0;
+    uint64_t nodes = 0;
+    uint64_t edges = 0;
+    uint64_t bytes = 0;
+  };
+
+  int l;
+  ThreadPool *pool;
+  bool verbose; // one line per level
+
+  explicit IsogenyGraphExplorer(int l, ThreadPool *pool = nullptr,
+                                bool verbose = true)
+      : l(l), pool(pool), verbose(verbose) {}
+
+  // Explores from the curve A0, which must be supersingular (A0 = 0, i.e.
+  // j = 1728, is whenever p = 3 mod 4, true for every Params here).
+  // max_nodes is a soft limit: levels are expanded while fewer nodes are
+  // known, and the level that crosses it is still written out completely.
+  Stats explore(const Fp2T &A0, uint64_t max_nodes, std::ostream &out) const {
+    Stats st;
+    if (l != 2 && l != 3) {
+      std::cerr << "IsogenyGraphExplorer: l = " << l << " not supported"
+                << std::endl;
+      return st;
+    }
+
+    EdgeStreamWriter<Config> writer(out, l);
+    ConcurrentFp2Map<Config, Claim> seen;
+    auto keep_min = [](const Claim &a, const Claim &b) {
+      return a.key <= b.key ? a : b;
+    };
+
+    std::vector<Node> frontier;
+    Fp2T j0 = Curve::j_invariant(A0);
+    uint32_t id0 = writer.node(j0);
+    seen.upsert(j0, Claim{0, id0}, keep_min);
+    frontier.push_back(Node{A0, j0, id0});
+
+    std::vector<std::vector<Fp2T>> curves, js;
+    for (uint64_t level = 1; !frontier.empty() && writer.nodes < max_nodes;
+         ++level) {
+      const size_t n = frontier.size();
+      const uint64_t base = level << 40;
+      curves.assign(n, {});
+      js.assign(n, {});
+
+      // Phase 1: neighbours and claims
+      for_each(n, [&](size_t i) {
+        Gen::neighbor_curves(l, frontier[i].A, curves[i]);
+        for (size_t k = 0; k < curves[i].size(); ++k) {
+          js[i].push_back(Curve::j_invariant(curves[i][k]));
+          seen.upsert(js[i].back(), Claim{base + position(i, k), UNSET},
+                      keep_min);
+        }
+      });
+
+      // Phase 2: new nodes in claim order, then edges
+      std::vector<Node> next;
+      for (size_t i = 0; i < n; ++i)
+        for (size_t k = 0; k < js[i].size(); ++k) {
+          Claim c;
+          seen.find(js[i][k], c);
+          if (c.key != base + position(i, k))
+            continue;
+          c.id = writer.node(js[i][k]);
+          seen.assign(js[i][k], c);
+          next.push_back(Node{curves[i][k], js[i][k], c.id});
+        }
+      for (size_t i = 0; i < n; ++i)
+        for (size_t k = 0; k < js[i].size(); ++k) {
+          Claim c;
+          seen.find(js[i][k], c);
+          writer.edge(frontier[i].id, c.id);
+        }
+
+      if (verbose) {
+        std::cout << "Level " << level << ": expanded " << n << ", "
+                  << next.size() << " new, " << writer.nodes << " nodes, "
+                  << writer.edges << " edges" << std::endl;
+      }
+      frontier = std::move(next);
+      st.levels = (size_t)level;
+    }
+
+    st.nodes = writer.nodes;
+    st.edges = writer.edges;
+    st.bytes = writer.bytes;
+    if (!writer.good())
+      std::cerr << "IsogenyGraphExplorer: write error" << std::endl;
+    return st;
+  }
+
+private:
+  static constexpr uint32_t UNSET = 0xFFFFFFFFu;
+
+  struct Node {
+    Fp2T A;
+    Fp2T j;
+    uint32_t id;
+  };
+
+  // First discovery of a j: (level << 40) | position, smallest wins
+  struct Claim {
+    uint64_t key = 0;
+    uint32_t id = UNSET;
+  };
+
+  uint64_t position(size_t i, size_t k) const {
+    return (uint64_t)i * (uint64_t)(l + 1) + k;
+  }
+
+  template <typename Func> void for_each(size_t n, Func &&fn) const {
+    if (pool) {
+      pool->parallel_for(n, fn);
+      return;
+    }
+    for (size_t i = 0; i < n; ++i)
+      fn(i);
+  }
+};
+
+} // namespace crypto
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace crypto {
+
+// Minimal Keccak-f[1600] implementation for SHA3-256
+// Based on standard reference logic
+class Keccak {
+  static const int NR = 24;
+  static const uint64_t RC[24];
+  static const int RHO_OFFSETS[5][5];
+
+  static uint64_t rotl64(uint64_t x, int i) {
+    return i == 0 ? x : (x << i) | (x >> (64 - i));
+  }
+
+public:
+  static void keccak_f1600(uint64_t *A) {
+    for (int round = 0; round < NR; ++round) {
+      // Theta
+      uint64_t C[5], D[5];
+      for (int x = 0; x < 5; ++x) {
+        C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
+      }
+      for (int x = 0; x < 5; ++x) {
+        D[x] = C[(x + 4) % 5] ^ rotl64(C[(x + 1) % 5], 1);
+      }
+      for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+          A[x + 5 * y] ^= D[x];
+        }
+      }
+
+      // Rho and Pi
+      uint64_t B[25];
+      for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+          B[y + 5 * ((2 * x + 3 * y) % 5)] =
+              rotl64(A[x + 5 * y], RHO_OFFSETS[y][x]);
+        }
+      }
+
+      // Chi
+      for (int x = 0; x < 5; ++x) {
+        for (int y = 0; y < 5; ++y) {
+          A[x + 5 * y] = B[x + 5 * y] ^
+                         ((~B[(x + 1) % 5 + 5 * y]) & B[(x + 2) % 5 + 5 * y]);
+        }
+      }
+
+      // Iota
+      A[0] ^= RC[round];
+    }
+  }
+};
+
+// Initialized constants (Need to be defined in a .cpp or inline if C++17)
+// For header-only, we can use inline variables or just static const inside
+// function/class if tricky. Let's rely on C++17 inline variables if possible,
+// or just define them here with 'inline' which is C++17 standard.
+inline const uint64_t Keccak::RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// Indexed [y][x]
+inline const int Keccak::RHO_OFFSETS[5][5] = {{0, 1, 62, 28, 27},
+                                              {36, 44, 6, 55, 20},
+                                              {3, 10, 43, 25, 39},
+                                              {41, 45, 15, 21, 8},
+                                              {18, 2, 61, 56, 14}};
+
+// One-shot SHA3-256 (rate 136 bytes, domain padding 0x06).
+// Used for content digests (cache files, hash-to-curve seeds), not for the
+// Fiat-Shamir transcript, which keeps its own sponge.
+inline void sha3_256(const uint8_t *data, size_t len, uint8_t out[32]) {
+  const size_t RATE = 136;
+  uint64_t st[25] = {0};
+  uint8_t *sb = (uint8_t *)st;
+  size_t pt = 0;
+  for (size_t i = 0; i < len; ++i) {
+    sb[pt++] ^= data[i];
+    if (pt == RATE) {
+      Keccak::keccak_f1600(st);
+      pt = 0;
+    }
+  }
+  sb[pt] ^= 0x06;
+  sb[RATE - 1] ^= 0x80;
+  Keccak::keccak_f1600(st);
+  memcpy(out, sb, 32);
+}
+
+} // namespace crypto
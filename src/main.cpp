@@ -62,14 +62,18 @@ int main() {
   using Probe = LinearizationProbe<Params>;
   using Fp2T = Fp2<Params>;
 
-  // Generate Phi_2
-  Generator::generate_phi(2);
+  // Generate Phi_2 and Phi_3 concurrently
+  ThreadPool pool;
+  Generator generator(&pool);
+  auto phis = generator.generate_phi(std::vector<int>{2, 3});
+  const auto &phi2 = phis[0];
+  const auto &phi3 = phis[1];
 
   // Probe Phi_2
-  if (Generator::pairs_found.size() >= 2) {
+  if (phi2.pairs_found.size() >= 2) {
     std::cout << "--- Probing Phi_2 Structure ---" << std::endl;
-    auto p1 = Generator::pairs_found[0];
-    auto p2 = Generator::pairs_found[1];
+    auto p1 = phi2.pairs_found[0];
+    auto p2 = phi2.pairs_found[1];
     Fp2T r = Fp2T::one(); // Use r=1 for simplicity or random
     // Random-ish r
     Fp2T r_rand;
@@ -77,9 +81,12 @@ int main() {
 
     Probe::compute_error(p1, p2, r_rand, 3);
 
+    // Fixed-capacity copy of Phi_2 for the analyzer and single folds
+    auto phi_rows = phi2.small_rows();
+
     // Run Analyzer
     using Analyzer = Phi2Analyzer<Params>;
-    Analyzer::analyze_phi2(Generator::phi_coeffs, p1, p2, r_rand);
+    Analyzer::analyze_phi2(phi_rows, p1, p2, r_rand);
 
     std::cout << "--- Testing Relaxed Folding Protocol ---" << std::endl;
     using Folder = RelaxedIsogenyFolder<Params>;
@@ -90,10 +97,10 @@ int main() {
     Witness w2 = {p2.first, p2.second, Fp2T::zero()};
 
     // Fold
-    Witness w_folded = Folder::fold(Generator::phi_coeffs, w1, w2, r_rand);
+    Witness w_folded = Folder::fold(phi_rows, w1, w2, r_rand);
 
     // Verify
-    if (Folder::verify(Generator::phi_coeffs, w_folded)) {
+    if (Folder::verify(phi_rows, w_folded)) {
       std::cout << "Relaxed Folding Verified! Phi(w_folded) == u_folded."
                 << std::endl;
     } else {
@@ -102,29 +109,25 @@ int main() {
 
     // Run Stress Test and Get Final Witness
     using Recursion = RecursiveIsogenyManager<Params>;
-    auto final_witness = Recursion::run_stress_test(Generator::phi_coeffs,
-                                                    Generator::pairs_found, 50);
+    auto final_witness =
+        Recursion::run_stress_test(phi2.phi_coeffs, phi2.pairs_found, 50);
 
     // On-Chain Vertex Verification
     using Verifier = SmartContractVerifier<Params>;
-    Verifier::verify_proof(Generator::phi_coeffs, final_witness);
+    Verifier::verify_proof(phi2.phi_coeffs, final_witness);
 
     // Run Error Growth Analysis
-    Recursion::run_error_analysis(Generator::phi_coeffs, Generator::pairs_found,
-                                  1000);
+    Recursion::run_error_analysis(phi2.phi_coeffs, phi2.pairs_found, 1000);
 
   } else {
     std::cout << "Not enough pairs for Phi_2 probe." << std::endl;
   }
 
-  // Generate Phi_3
-  Generator::generate_phi(3);
-
   // Probe Phi_3
-  if (Generator::pairs_found.size() >= 2) {
+  if (phi3.pairs_found.size() >= 2) {
     std::cout << "--- Probing Phi_3 Structure ---" << std::endl;
-    auto p1 = Generator::pairs_found[0];
-    auto p2 = Generator::pairs_found[1];
+    auto p1 = phi3.pairs_found[0];
+    auto p2 = phi3.pairs_found[1];
     Fp2T r_rand;
     r_rand.c0.val.limbs[0] = 7;
 
@@ -249,7 +252,7 @@ int main() {
 
   // --- Q-HALO PROTOCOL: FINAL INTEGRATION ---
   using QHalo = QHaloProtocol<Params>;
-  QHalo::run_protocol(Generator::phi_coeffs, Generator::pairs_found, 10);
+  QHalo::run_protocol(phi3.phi_coeffs, phi3.pairs_found, 10);
 
   return 0;
 }
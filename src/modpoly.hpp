@@ -1,14 +1,56 @@
 #pragma once
 
+#include "cache_io.hpp"
 #include "curve.hpp"
 #include "fp2.hpp"
 #include "isogeny.hpp"
 #include "poly.hpp"
+#include "roots.hpp"
+#include "small_poly.hpp"
+#include "thread_pool.hpp"
 #include <random>
+#include <sstream>
 #include <vector>
 
 namespace crypto {
 
+// Phi_l(X, Y) = sum_k c_k(Y) X^k as produced by ModularPolynomialGenerator
+template <typename Config> struct ModularPolynomial {
+  using Fp2T = Fp2<Config>;
+
+  // Generation handles l <= 3, so every neighbour polynomial and every row
+  // of Phi_l has degree <= l + 1 <= MAX_DEG and fits a SmallPoly.
+  static constexpr size_t MAX_DEG = 4;
+  using Row = SmallPoly<Fp2T, MAX_DEG>;
+
+  int l = 0;
+  // Weber polynomial Phi^W_l (generate_weber): X, Y and the pairs below are
+  // Weber function values f, not j-invariants
+  bool weber = false;
+  // c_k(Y), the coefficient of X^k (Phi is symmetric, so these double as
+  // the rows indexed by powers of Y that Phi2Analyzer expects)
+  std::vector<Polynomial<Fp2T>> phi_coeffs;
+  // (j, j') pairs of l-isogenous curves met while sampling, for the probe
+  std::vector<std::pair<Fp2T, Fp2T>> pairs_found;
+  // false if the field ran out of distinct j before l + 2 data points
+  bool complete = false;
+
+  // phi_coeffs as fixed-capacity rows, for the analyzer and folding paths
+  // (classical Phi_l only; Weber rows have degree l + 1 > MAX_DEG)
+  std::vector<Row> small_rows() const {
+    std::vector<Row> rows;
+    for (auto &c : phi_coeffs)
+      rows.push_back(Row(c));
+    return rows;
+  }
+};
+
+// Interpolates Phi_l from sampled curves. Instances hold only settings; all
+// results are returned by value, so several generators (or several l on one
+// generator) can run at the same time.
+// With a ThreadPool the data points and the per-coefficient interpolations
+// are fanned out over it. Seeds are still consumed in increasing order, so
+// the output is identical for every pool size, including none.
 template <typename Config> class ModularPolynomialGenerator {
   using FpT = Fp<Config>;
   using Fp2T = Fp2<Config>;
@@ -18,191 +60,119 @@ template <typename Config> class ModularPolynomialGenerator {
   using Iso = Isogeny<Config>;
 
 public:
-  // Helper: Find roots of polynomial over Fp2.
-  // Supports brute force for small fields.
-  static std::vector<Fp2T> find_roots(const std::vector<Fp2T> &poly_coeffs) {
-    std::vector<Fp2T> roots;
-
-    // Brute force check for small p
-    // Fp2 size is p^2. For p=19, size=361. Very fast.
-    // For larger p, this will hang.
-    BigInt<Config::N_LIMBS> p_val = Config::p();
-    if (p_val.limbs[0] > 1000) {
-      std::cerr << "Warning: Brute force root finding on large field!"
-                << std::endl;
-      // Here we would need Cantor-Zassenhaus
-      return roots;
-    }
+  using Result = ModularPolynomial<Config>;
+  using PhiRow = typename Result::Row;
+  static constexpr size_t MAX_PHI_DEG = Result::MAX_DEG;
 
-    uint64_t lim = p_val.limbs[0];
-    for (uint64_t u0 = 0; u0 < lim; ++u0) {
-      for (uint64_t u1 = 0; u1 < lim; ++u1) {
-        BigInt<Config::N_LIMBS> b0, b1;
-        b0.limbs[0] = u0;
-        b1.limbs[0] = u1;
-        FpT f0(b0);
-        f0 = FpT::mul(f0, FpT(Config::R2()));
-        FpT f1(b1);
-        f1 = FpT::mul(f1, FpT(Config::R2()));
-        Fp2T x(f0, f1);
-
-        // Eval
-        Fp2T val; // 0
-        // Horner
-        if (!poly_coeffs.empty()) {
-          val = poly_coeffs.back();
-          for (int k = (int)poly_coeffs.size() - 2; k >= 0; --k) {
-            val = Fp2T::mul(val, x);
-            val = Fp2T::add(val, poly_coeffs[k]);
-          }
-        }
+  ThreadPool *pool;
+  bool use_cache; // false forces regeneration (and skips writing the cache)
+  bool verbose;   // print data points and coefficients
 
-        if (val.c0.data().is_zero() && val.c1.data().is_zero()) {
-          roots.push_back(x);
-        }
-      }
-    }
-    return roots;
+  // pool == nullptr runs everything on the calling thread
+  explicit ModularPolynomialGenerator(ThreadPool *pool = nullptr,
+                                      bool use_cache = true,
+                                      bool verbose = true)
+      : pool(pool), use_cache(use_cache), verbose(verbose) {}
+
+  // Helper: Find roots of polynomial over Fp2.
+  // Equal-degree factorisation (see roots.hpp); works for any field size.
+  static std::vector<Fp2T> find_roots(const std::vector<Fp2T> &poly_coeffs) {
+    return RootFinder<Config>::find_roots(poly_coeffs);
   }
 
   // Generate Phi_l(X, Y)
   // l = 2 or 3
-  static std::vector<std::pair<Fp2T, Fp2T>> generate_phi(int l) {
-    std::cout << "Generating Phi_" << l << "..." << std::endl;
+  // Results are cached on disk per (p, l); a valid cache file is mapped and
+  // loaded instead of regenerating (and printing) everything.
+  Result generate_phi(int l) const { return generate_phi(l, std::cout); }
+
+  // Several l at once, one pool task each. Logs are buffered per l and
+  // printed in the order of ls once everything is done.
+  std::vector<Result> generate_phi(const std::vector<int> &ls) const {
+    std::vector<Result> results(ls.size());
+    std::vector<std::ostringstream> logs(ls.size());
+    for_each(ls.size(),
+             [&](size_t i) { results[i] = generate_phi(ls[i], logs[i]); });
+    for (auto &log : logs)
+      std::cout << log.str();
+    return results;
+  }
+
+  Result generate_phi(int l, std::ostream &log) const {
+    Result res;
+    res.l = l;
+    if (use_cache && load_cached(l, res)) {
+      log << "Loaded Phi_" << l << " from cache" << std::endl;
+      return res;
+    }
 
-    // Clear previous
-    pairs_found.clear();
+    log << "Generating Phi_" << l << "..." << std::endl;
 
     // We need l+2 points for interpolation of degree l+1 polynomial (in Y).
     // Degree of Phi_l(X, Y) in Y is l+1.
-    int required_points = l + 2;
-
-    std::vector<std::pair<Fp2T, Poly>> data_points;
-
-    // Random generator for A
-    // Just deterministic scan for stability or random
-    uint64_t seed = 1;
-
-    while (data_points.size() < required_points) {
-      seed++;
-      // Generate valid A
-      BigInt<Config::N_LIMBS> bA;
-      bA.limbs[0] = seed;
-      FpT fA(bA);
-      fA = FpT::mul(fA, FpT(Config::R2()));
-      Fp2T A(fA, FpT::zero()); // Real A for simplicity
-
-      // Check if supersingular? Or generic.
-      // Modular polynomials are valid for ALL curves.
-      // Compute j
-      Fp2T j_val = Curve::j_invariant(A);
-
-      // Find Kernels
+    size_t required_points = l + 2;
+
+    std::vector<std::pair<Fp2T, PhiRow>> data_points;
+
+    // Deterministic scan over A = 2, 3, ... Seeds are sampled one per pool
+    // thread at a time in parallel, then accepted strictly in seed order,
+    // which picks exactly the points a serial scan would.
+    // Tiny fields (ParamsSmall) may not have l + 2 distinct usable j at all;
+    // give up after a fixed scan instead of looping forever.
+    const uint64_t SEED_LIMIT = 4096;
+    const size_t SEED_BATCH = pool ? pool->size() : 1;
+    res.complete = true;
+
+    struct Sample {
+      bool ok = false;
+      Fp2T j;
       std::vector<Fp2T> neighbors;
+    };
+    std::vector<Sample> batch(SEED_BATCH);
+
+    for (uint64_t first = 2; data_points.size() < required_points;
+         first += SEED_BATCH) {
+      if (first >= SEED_LIMIT) {
+        std::cerr << "generate_phi: only " << data_points.size() << " of "
+                  << required_points << " distinct j found; Phi_" << l
+                  << " is underdetermined over this field" << std::endl;
+        res.complete = false;
+        break;
+      }
+      for_each(SEED_BATCH, [&](size_t i) {
+        batch[i].ok = sample(l, first + i, batch[i].j, batch[i].neighbors);
+      });
 
-      if (l == 2) {
-        // Roots of x(x^2 + Ax + 1)
-        // x1 = 0.
-        // x2, x3 roots of x^2 + Ax + 1.
-        // We can solve quadratic directly without brute force.
-        // x = (-A +/- sqrt(A^2 - 4))/2
-
-        Fp2T A2 = Fp2T::sqr(A);
-        Fp2T four;
-        four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
-        Fp2T disc = Fp2T::sub(A2, four);
-        Fp2T sqrt_disc = Fp2T::sqrt(disc);
-
-        // If sqrt fails (non-QR and not handled), we skip
-        // Our Fp2::sqrt handles everything now.
-
-        Fp2T two;
-        two.c0 = FpT(BigInt<Config::N_LIMBS>(2)).to_montgomery();
-        Fp2T inv2 = Fp2T::inv(two);
-
-        Fp2T negA = Fp2T::sub(Fp2T::zero(), A);
-        Fp2T num1 = Fp2T::add(negA, sqrt_disc);
-        Fp2T num2 = Fp2T::sub(negA, sqrt_disc);
-
-        Fp2T r1 = Fp2T::mul(num1, inv2);
-        Fp2T r2 = Fp2T::mul(num2, inv2);
-
-        std::vector<Point> kernels;
-        // (0:1)
-        kernels.push_back(
-            Point{Fp2T::zero(), Fp2T(FpT::mont_one(), FpT::zero())});
-        // (r1:1)
-        kernels.push_back(Point{r1, Fp2T(FpT::mont_one(), FpT::zero())});
-        // (r2:1)
-        kernels.push_back(Point{r2, Fp2T(FpT::mont_one(), FpT::zero())});
-
-        // Compute 3 neighbors
-        for (auto &K : kernels) {
-          auto res = Iso::Compute2IsoCurve(K);
-          // res is (A', C')
-          Fp2T A_prime = res.first;
-          Fp2T C_prime = res.second;
-          Fp2T A_norm = Fp2T::mul(A_prime, Fp2T::inv(C_prime));
-          Fp2T j_new = Curve::j_invariant(A_norm);
-          neighbors.push_back(j_new);
-        }
-      } else if (l == 3) {
-        // Roots of 3x^4 + 4Ax^3 + 6x^2 - 1
-        // Use brute force finder
-        std::vector<Fp2T> p_coeffs(5);
-        // -1
-        p_coeffs[0] =
-            Fp2T::sub(Fp2T::zero(), Fp2T(FpT::mont_one(), FpT::zero()));
-        p_coeffs[1] = Fp2T::zero();
-        // 6
-        p_coeffs[2] =
-            Fp2T(FpT(BigInt<Config::N_LIMBS>(6)).to_montgomery(), FpT::zero());
-        // 4A
-        Fp2T four;
-        four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
-        p_coeffs[3] = Fp2T::mul(four, A);
-        // 3
-        p_coeffs[4] =
-            Fp2T(FpT(BigInt<Config::N_LIMBS>(3)).to_montgomery(), FpT::zero());
-
-        std::vector<Fp2T> roots = find_roots(p_coeffs);
-
-        if (roots.size() < 4) {
-          // Not split? Skip this A.
+      for (size_t i = 0;
+           i < SEED_BATCH && data_points.size() < required_points; ++i) {
+        if (!batch[i].ok)
+          continue;
+        const Fp2T &j_val = batch[i].j;
+        const std::vector<Fp2T> &neighbors = batch[i].neighbors;
+
+        // Interpolation needs distinct j; distinct A can share one
+        bool repeated = false;
+        for (auto &dp : data_points)
+          repeated = repeated || Fp2T::equal(dp.first, j_val);
+        if (repeated)
           continue;
-        }
 
-        // Roots are x-coords of kernels.
-        for (auto &x : roots) {
-          Point K{x, Fp2T(FpT::mont_one(), FpT::zero())};
-          Fp2T C_in = Fp2T(FpT::mont_one(), FpT::zero());
-          auto res = Iso::Compute3IsoCurve(K, A, C_in);
-          Fp2T A_norm = Fp2T::mul(res.first, Fp2T::inv(res.second));
-          Fp2T j_new = Curve::j_invariant(A_norm);
-          neighbors.push_back(j_new);
+        // Construct Phi_l(X, j) = prod (X - neighbors)
+        PhiRow uni_poly;
+        PhiRow::from_roots_into(uni_poly, neighbors.data(), neighbors.size());
+        if (verbose) {
+          log << "Data point " << data_points.size() << ": j=";
+          j_val.print(log);
+          log << std::endl;
+          log << "UniPoly deg=" << uni_poly.deg() << std::endl;
+          uni_poly.to_poly().print("UP", log);
         }
-      }
 
-      // Construct Phi_l(X, j) = prod (X - neighbors)
-      Poly uni_poly = Poly::one(Fp2T::mont_one());
-      for (auto &neighbor : neighbors) {
-        // (X - neighbor)
-        Poly term = Poly::x(Fp2T::mont_one(), Fp2T::zero());
-        Poly const_j(neighbor);
-        term = Poly::sub(term, const_j);
-        uni_poly = Poly::mul(uni_poly, term);
-      }
-      std::cout << "Data point " << data_points.size() << ": j=";
-      j_val.print();
-      std::cout << std::endl;
-      std::cout << "UniPoly deg=" << uni_poly.coeffs.size() - 1 << std::endl;
-      uni_poly.print("UP");
-
-      data_points.push_back({j_val, uni_poly});
+        data_points.push_back({j_val, uni_poly});
 
-      // Save pairs (j, neighbor) for probe
-      for (auto &n : neighbors) {
-        pairs_found.push_back({j_val, n});
+        // Save pairs (j, neighbor) for probe
+        for (auto &n : neighbors)
+          res.pairs_found.push_back({j_val, n});
       }
     }
 
@@ -212,54 +182,372 @@ public:
     // So for each coefficient index k, we have a list of pairs (Y_i,
     // coeff_k_of_P_i). We interpolate these to find c_k(Y).
 
+    // Every c_k is interpolated over the same Y_i, so one subproduct tree
+    // (and one set of Lagrange weights) serves all l + 2 columns; the
+    // columns themselves are independent and run in parallel.
+
     int deg_x = l + 1;                         // Expected degree
     std::vector<Poly> final_coeffs(deg_x + 1); // c_k(Y)
 
-    for (int k = 0; k <= deg_x; ++k) {
-      std::vector<std::pair<Fp2T, Fp2T>> points_for_k;
+    std::vector<Fp2T> y_vals;
+    for (auto &dp : data_points)
+      y_vals.push_back(dp.first);
+    SubproductTree<Fp2T> tree(y_vals);
+    tree.prepare_interpolation();
+
+    for_each(deg_x + 1, [&](size_t k) {
+      std::vector<Fp2T> coeffs_k;
       for (auto &dp : data_points) {
-        Fp2T y_val = dp.first;
-        Poly &poly_x = dp.second;
-        Fp2T coeff_val =
-            (k < poly_x.coeffs.size()) ? poly_x.coeffs[k] : Fp2T::zero();
-        points_for_k.push_back({y_val, coeff_val});
+        const PhiRow &poly_x = dp.second;
+        coeffs_k.push_back((k < poly_x.len) ? poly_x.coeffs[k] : Fp2T::zero());
       }
 
-      final_coeffs[k] = Poly::interpolate(points_for_k);
+      final_coeffs[k] = tree.interpolate(coeffs_k);
+    });
+
+    if (verbose) {
+      log << "Phi_" << l << "(X, Y) Coefficients:" << std::endl;
+      for (int k = 0; k <= deg_x; ++k) {
+        log << "Coeff of X^" << k << " (Polynomial in Y):" << std::endl;
+        final_coeffs[k].print("   C", log);
+      }
     }
 
-    // We assume the caller handles the 2D structure.
-    // We return a Polynomial in X, but coefficients are actually Polynomials in
-    // Y? Or we flatten it? Let's print the result here and return just the
-    // X-poly where coeffs are evaluated at Y=0? No. The task asks to "Print the
-    // coefficients". I will print them.
+    res.phi_coeffs = std::move(final_coeffs);
+
+    if (use_cache && res.complete)
+      store_cached(res);
+
+    return res;
+  }
 
-    std::cout << "Phi_" << l << "(X, Y) Coefficients:" << std::endl;
-    for (int k = 0; k <= deg_x; ++k) {
-      std::cout << "Coeff of X^" << k << " (Polynomial in Y):" << std::endl;
-      final_coeffs[k].print("   C");
+  // Weber modular polynomial Phi^W_l(X, Y), l = 5, 7 or 11
+  // Relates Weber function values f(tau), f(l tau), with
+  // j = (f^24 - 16)^3 / f^24 (WeberPhi::j_invariant). Degree l + 1 in each
+  // variable like Phi_l, but only 4 to 8 nonzero terms with small integer
+  // coefficients (Phi_l has ~(l + 2)^2 / 2 distinct ones, hundreds of bits
+  // wide), so it is written down directly instead of interpolated.
+  // pairs_found holds (f, f') for f = 2, 3, ... and every root f' of
+  // Phi^W_l(f, Y) in Fp2, from the first l + 2 seeds that have one.
+  Result generate_weber(int l) const { return generate_weber(l, std::cout); }
+
+  Result generate_weber(int l, std::ostream &log) const {
+    Result res;
+    res.l = l;
+    res.weber = true;
+    std::vector<WeberTerm> terms = weber_terms(l);
+    if (terms.empty()) {
+      std::cerr << "generate_weber: no Weber polynomial for l = " << l
+                << " (supported: 5, 7, 11)" << std::endl;
+      return res;
     }
 
-    // Store coeffs for analyzer
-    phi_coeffs = final_coeffs;
+    log << "Building Weber Phi^W_" << l << "..." << std::endl;
+
+    res.phi_coeffs.assign(l + 2, Poly());
+    for (auto &c : res.phi_coeffs)
+      c.coeffs.assign(l + 2, Fp2T::zero());
+    for (auto &t : terms)
+      res.phi_coeffs[t.x].coeffs[t.y] = from_int(t.c);
+
+    // Same in-order batch scan as generate_phi
+    const size_t required_seeds = l + 2;
+    const uint64_t SEED_LIMIT = 4096;
+    const size_t SEED_BATCH = pool ? pool->size() : 1;
+    std::vector<Fp2T> batch_f(SEED_BATCH);
+    std::vector<std::vector<Fp2T>> batch_roots(SEED_BATCH);
+    size_t seeds = 0;
+    res.complete = true;
+
+    for (uint64_t first = 2; seeds < required_seeds; first += SEED_BATCH) {
+      if (first >= SEED_LIMIT) {
+        std::cerr << "generate_weber: only " << seeds << " of "
+                  << required_seeds << " seeds with rational roots"
+                  << std::endl;
+        res.complete = false;
+        break;
+      }
+      for_each(SEED_BATCH, [&](size_t i) {
+        batch_f[i] = from_int((int64_t)(first + i));
+        // Phi^W_l(f, Y) = sum_k c_k(Y) f^k
+        Poly uni(std::vector<Fp2T>(l + 2, Fp2T::zero()));
+        Fp2T fk = Fp2T::one();
+        for (auto &c : res.phi_coeffs) {
+          for (size_t d = 0; d < c.coeffs.size(); ++d)
+            uni.coeffs[d] =
+                Fp2T::add(uni.coeffs[d], Fp2T::mul(c.coeffs[d], fk));
+          fk = Fp2T::mul(fk, batch_f[i]);
+        }
+        batch_roots[i] = RootFinder<Config>::find_roots(uni);
+      });
+
+      for (size_t i = 0; i < SEED_BATCH && seeds < required_seeds; ++i) {
+        // f = 0 (a multiple of p) has no j
+        if (batch_f[i].is_zero() || batch_roots[i].empty())
+          continue;
+        if (verbose) {
+          log << "Seed f=" << first + i << ": " << batch_roots[i].size()
+              << " roots" << std::endl;
+        }
+        for (auto &r : batch_roots[i])
+          res.pairs_found.push_back({batch_f[i], r});
+        ++seeds;
+      }
+    }
 
-    // Return the pairs found for the probe
-    return pairs_found;
+    if (verbose) {
+      log << "Phi^W_" << l << "(X, Y) Coefficients:" << std::endl;
+      for (auto &t : terms)
+        log << "   " << t.c << " X^" << t.x << " Y^" << t.y << std::endl;
+    }
+    return res;
   }
 
-  // Structure to hold just pairs for probe
-  static std::vector<std::pair<Fp2T, Fp2T>> pairs_found;
-  // Structure to hold coefficients for analyzer
-  static std::vector<Poly> phi_coeffs;
-};
+  // --- Phi cache ---
+  // Payload: key (p, l), then the X-coefficients c_k(Y) as length-prefixed
+  // Fp2 arrays, then the probe pairs. Elements are stored in Montgomery form.
+
+  static std::string cache_path(int l) {
+    std::vector<uint8_t> key = cache_key(l);
+    uint8_t digest[32];
+    sha3_256(key.data(), key.size(), digest);
+    return CacheIO::path_for("phi_" + std::to_string(l) + "_" +
+                             CacheIO::hex(digest, 8) + ".bin");
+  }
+
+  static bool load_cached(int l, Result &out) {
+    MappedFile map;
+    if (!map.open(cache_path(l)))
+      return false;
+    const uint8_t *buf;
+    size_t size;
+    if (!CacheIO::validate(map.data(), map.size(), CacheIO::KIND_MODULAR_POLY,
+                           CACHE_VERSION, buf, size))
+      return false;
+
+    std::vector<uint8_t> key = cache_key(l);
+    if (size < key.size() || memcmp(buf, key.data(), key.size()) != 0)
+      return false;
+    size_t off = key.size();
+
+    uint64_t n_coeffs, n_pairs;
+    if (!CacheIO::get(buf, size, off, n_coeffs))
+      return false;
+    std::vector<Poly> coeffs(n_coeffs);
+    for (auto &c : coeffs) {
+      uint64_t len;
+      if (!CacheIO::get(buf, size, off, len))
+        return false;
+      c.coeffs.resize(len);
+      for (auto &v : c.coeffs)
+        if (!CacheIO::get_fp2(buf, size, off, v))
+          return false;
+    }
+    if (!CacheIO::get(buf, size, off, n_pairs))
+      return false;
+    std::vector<std::pair<Fp2T, Fp2T>> pairs(n_pairs);
+    for (auto &pr : pairs)
+      if (!CacheIO::get_fp2(buf, size, off, pr.first) ||
+          !CacheIO::get_fp2(buf, size, off, pr.second))
+        return false;
+    if (off != size)
+      return false;
+
+    out.l = l;
+    out.phi_coeffs = std::move(coeffs);
+    out.pairs_found = std::move(pairs);
+    out.complete = true;
+    return true;
+  }
+
+  static void store_cached(const Result &res) {
+    int l = res.l;
+    std::vector<uint8_t> buf = cache_key(l);
+    CacheIO::put(buf, (uint64_t)res.phi_coeffs.size());
+    for (auto &c : res.phi_coeffs) {
+      CacheIO::put(buf, (uint64_t)c.coeffs.size());
+      for (auto &v : c.coeffs)
+        CacheIO::put_fp2(buf, v);
+    }
+    CacheIO::put(buf, (uint64_t)res.pairs_found.size());
+    for (auto &pr : res.pairs_found) {
+      CacheIO::put_fp2(buf, pr.first);
+      CacheIO::put_fp2(buf, pr.second);
+    }
+    if (!CacheIO::write_atomic(cache_path(l), CacheIO::KIND_MODULAR_POLY,
+                               CACHE_VERSION, buf))
+      std::cerr << "Warning: could not write Phi_" << l << " cache"
+                << std::endl;
+  }
 
-template <typename Config>
-std::vector<std::pair<typename ModularPolynomialGenerator<Config>::Fp2T,
-                      typename ModularPolynomialGenerator<Config>::Fp2T>>
-    ModularPolynomialGenerator<Config>::pairs_found;
+  static constexpr uint32_t CACHE_VERSION = 1;
 
-template <typename Config>
-std::vector<typename ModularPolynomialGenerator<Config>::Poly>
-    ModularPolynomialGenerator<Config>::phi_coeffs;
+private:
+  template <typename Func> void for_each(size_t n, Func &&fn) const {
+    if (pool) {
+      pool->parallel_for(n, fn);
+      return;
+    }
+    for (size_t i = 0; i < n; ++i)
+      fn(i);
+  }
+
+  struct WeberTerm {
+    int x, y;  // c X^x Y^y
+    int64_t c;
+  };
+
+  // Sutherland's tables; symmetric, so both mirrored terms are listed
+  static std::vector<WeberTerm> weber_terms(int l) {
+    switch (l) {
+    case 5:
+      return {{6, 0, 1}, {0, 6, 1}, {5, 5, -1}, {1, 1, 4}};
+    case 7:
+      return {{8, 0, 1}, {0, 8, 1}, {7, 7, -1}, {4, 4, 7}, {1, 1, -8}};
+    case 11:
+      return {{12, 0, 1}, {0, 12, 1}, {11, 11, -1}, {9, 9, 11},
+              {7, 7, -44}, {5, 5, 88},  {3, 3, -88},  {1, 1, 32}};
+    default:
+      return {};
+    }
+  }
+
+  // Small signed integer as an Fp2 element (Montgomery form)
+  static Fp2T from_int(int64_t c) {
+    uint64_t mag = c < 0 ? (uint64_t)(-c) : (uint64_t)c;
+    BigInt<Config::N_LIMBS> b;
+    b.limbs[0] = mag;
+    FpT v = FpT::mul(FpT(b), FpT(Config::R2()));
+    Fp2T r(v, FpT::zero());
+    return c < 0 ? Fp2T::sub(Fp2T::zero(), r) : r;
+  }
+
+  // One data point: A from the seed, its j and the j of its l + 1
+  // l-isogenous neighbours. false if the seed gives no usable curve. Pure
+  // function of (l, seed), so data points can be sampled in any order.
+  static bool sample(int l, uint64_t seed, Fp2T &j_val,
+                     std::vector<Fp2T> &neighbors) {
+    // Generate valid A
+    BigInt<Config::N_LIMBS> bA;
+    bA.limbs[0] = seed;
+    FpT fA(bA);
+    fA = FpT::mul(fA, FpT(Config::R2()));
+    Fp2T A(fA, FpT::zero()); // Real A for simplicity
+
+    // No supersingularity filter (SupersingularityTest) here: modular
+    // polynomials are valid for ALL curves.
+    // ...except singular ones: A = +-2 gives a garbage j and poisons the
+    // interpolation.
+    Fp2T four;
+    four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
+    if (Fp2T::sub(Fp2T::sqr(A), four).is_zero())
+      return false;
+
+    // Compute j
+    j_val = Curve::j_invariant(A);
+
+    std::vector<Fp2T> curves;
+    if (!neighbor_curves(l, A, curves) || curves.size() < (size_t)l + 1)
+      return false; // Not split? Skip this A.
+
+    neighbors.clear();
+    for (auto &A_next : curves)
+      neighbors.push_back(Curve::j_invariant(A_next));
+    return true;
+  }
+
+public:
+  // Montgomery coefficients A' of the curves l-isogenous to y^2 = x^3 +
+  // A x^2 + x (l = 2 or 3), one per kernel whose generator is rational over
+  // Fp2; fewer than l + 1 when the l-torsion does not split. Also the step
+  // function of IsogenyGraphExplorer.
+  static bool neighbor_curves(int l, const Fp2T &A, std::vector<Fp2T> &out) {
+    out.clear();
+    if (l == 2) {
+      // Roots of x(x^2 + Ax + 1)
+      // x1 = 0.
+      // x2, x3 roots of x^2 + Ax + 1.
+      // We can solve quadratic directly without brute force.
+      // x = (-A +/- sqrt(A^2 - 4))/2
+
+      Fp2T A2 = Fp2T::sqr(A);
+      Fp2T four;
+      four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
+      Fp2T disc = Fp2T::sub(A2, four);
+      Fp2T sqrt_disc = Fp2T::sqrt(disc);
+
+      // If sqrt fails (non-QR and not handled), we skip
+      // Our Fp2::sqrt handles everything now.
+
+      Fp2T two;
+      two.c0 = FpT(BigInt<Config::N_LIMBS>(2)).to_montgomery();
+      Fp2T inv2 = Fp2T::inv(two);
+
+      Fp2T negA = Fp2T::sub(Fp2T::zero(), A);
+      Fp2T num1 = Fp2T::add(negA, sqrt_disc);
+      Fp2T num2 = Fp2T::sub(negA, sqrt_disc);
+
+      Fp2T r1 = Fp2T::mul(num1, inv2);
+      Fp2T r2 = Fp2T::mul(num2, inv2);
+
+      std::vector<Point> kernels;
+      // (0:1)
+      kernels.push_back(
+          Point{Fp2T::zero(), Fp2T(FpT::mont_one(), FpT::zero())});
+      // (r1:1)
+      kernels.push_back(Point{r1, Fp2T(FpT::mont_one(), FpT::zero())});
+      // (r2:1)
+      kernels.push_back(Point{r2, Fp2T(FpT::mont_one(), FpT::zero())});
+
+      // Compute 3 neighbors
+      for (auto &K : kernels) {
+        auto res = K.X.is_zero() ? Iso::Compute2IsoCurveZero(A)
+                                 : Iso::Compute2IsoCurve(K);
+        // res is (A', C')
+        Fp2T A_prime = res.first;
+        Fp2T C_prime = res.second;
+        out.push_back(Fp2T::mul(A_prime, Fp2T::inv(C_prime)));
+      }
+    } else if (l == 3) {
+      // Roots of 3x^4 + 4Ax^3 + 6x^2 - 1
+      std::vector<Fp2T> p_coeffs(5);
+      // -1
+      p_coeffs[0] =
+          Fp2T::sub(Fp2T::zero(), Fp2T(FpT::mont_one(), FpT::zero()));
+      p_coeffs[1] = Fp2T::zero();
+      // 6
+      p_coeffs[2] =
+          Fp2T(FpT(BigInt<Config::N_LIMBS>(6)).to_montgomery(), FpT::zero());
+      // 4A
+      Fp2T four;
+      four.c0 = FpT(BigInt<Config::N_LIMBS>(4)).to_montgomery();
+      p_coeffs[3] = Fp2T::mul(four, A);
+      // 3
+      p_coeffs[4] =
+          Fp2T(FpT(BigInt<Config::N_LIMBS>(3)).to_montgomery(), FpT::zero());
+
+      std::vector<Fp2T> roots = find_roots(p_coeffs);
+
+      // Roots are x-coords of kernels.
+      for (auto &x : roots) {
+        Point K{x, Fp2T(FpT::mont_one(), FpT::zero())};
+        Fp2T C_in = Fp2T(FpT::mont_one(), FpT::zero());
+        auto res = Iso::Compute3IsoCurve(K, A, C_in);
+        out.push_back(Fp2T::mul(res.first, Fp2T::inv(res.second)));
+      }
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+private:
+  static std::vector<uint8_t> cache_key(int l) {
+    std::vector<uint8_t> key;
+    CacheIO::put(key, Config::p().limbs);
+    CacheIO::put(key, (int32_t)l);
+    return key;
+  }
+};
 
 } // namespace crypto
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "cross_terms.hpp"
+#include "modpoly.hpp"
+#include "relaxed_folding.hpp"
+#include <iostream>
+#include <vector>
+
+namespace crypto {
+
+// Modular polynomial families the folding relation can run on.
+// A family says which l it supports, how to build its polynomial and how
+// its variables map back to j-invariants. MAX_TOTAL_DEG bounds
+// max{i + j : c_ij != 0} over the supported l and sizes the cross terms.
+
+// Classical Phi_l(j, j'), interpolated by generate_phi (l = 2, 3)
+template <typename Config> struct ClassicalPhi {
+  using Fp2T = Fp2<Config>;
+  using Generator = ModularPolynomialGenerator<Config>;
+
+  static constexpr const char *NAME = "classical";
+  static constexpr size_t MAX_TOTAL_DEG = 8;
+
+  static bool supports(int l) { return l == 2 || l == 3; }
+
+  static typename Generator::Result generate(const Generator &gen, int l) {
+    return gen.generate_phi(l);
+  }
+
+  static Fp2T j_invariant(const Fp2T &x) { return x; }
+};
+
+// Weber Phi^W_l(f, f'), written down by generate_weber (l = 5, 7, 11)
+// Same degree in each variable as Phi_l but 4 to 8 terms, so one fold costs
+// about as much as a classical Phi_2 fold even for l = 11.
+template <typename Config> struct WeberPhi {
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  using Generator = ModularPolynomialGenerator<Config>;
+
+  static constexpr const char *NAME = "weber";
+  static constexpr size_t MAX_TOTAL_DEG = 22; // X^11 Y^11 in Phi^W_11
+
+  static bool supports(int l) { return l == 5 || l == 7 || l == 11; }
+
+  static typename Generator::Result generate(const Generator &gen, int l) {
+    return gen.generate_weber(l);
+  }
+
+  // j = (f^24 - 16)^3 / f^24
+  static Fp2T j_invariant(const Fp2T &f) {
+    Fp2T f2 = Fp2T::sqr(f);
+    Fp2T f4 = Fp2T::sqr(f2);
+    Fp2T f8 = Fp2T::sqr(f4);
+    Fp2T f24 = Fp2T::mul(Fp2T::sqr(f8), f8);
+    Fp2T sixteen;
+    sixteen.c0 = FpT(BigInt<Config::N_LIMBS>(16)).to_montgomery();
+    Fp2T t = Fp2T::sub(f24, sixteen);
+    return Fp2T::mul(Fp2T::mul(Fp2T::sqr(t), t), Fp2T::inv(f24));
+  }
+};
+
+// The relaxed relation Phi(x, y) = u for one family and one l: the
+// compiled polynomial, its cross-term engine and the sampled edges.
+// Folding goes through RelaxedIsogenyFolder / CrossTermEngine unchanged;
+// only the polynomial (and what its variables mean) comes from Family.
+template <typename Config, typename Family = ClassicalPhi<Config>>
+class ModularRelation {
+  using Fp2T = Fp2<Config>;
+  using Folder = RelaxedIsogenyFolder<Config>;
+
+public:
+  using Witness = typename Folder::RelaxedWitness;
+  using Engine = CrossTermEngine<Config, Family::MAX_TOTAL_DEG>;
+  using Terms = typename Engine::Terms;
+  using MultiTerms = typename Engine::MultiTerms;
+
+  int l = 0;
+  BivariatePoly<Fp2T> phi;
+  Engine engine;
+  std::vector<std::pair<Fp2T, Fp2T>> pairs; // edges (x, y) with Phi = 0
+
+  ModularRelation() {}
+
+  ModularRelation(const ModularPolynomialGenerator<Config> &gen, int l)
+      : l(l) {
+    if (!Family::supports(l)) {
+      std::cerr << "ModularRelation: " << Family::NAME
+                << " family has no l = " << l << std::endl;
+      this->l = 0;
+      return;
+    }
+    auto res = Family::generate(gen, l);
+    phi = BivariatePoly<Fp2T>::from_rows(res.phi_coeffs);
+    engine = Engine(phi);
+    pairs = std::move(res.pairs_found);
+  }
+
+  bool valid() const { return l != 0 && !phi.dense.empty(); }
+
+  // Edge i as a fresh (u = 0) witness
+  Witness witness(size_t i) const {
+    return Witness{pairs[i].first, pairs[i].second, Fp2T::zero()};
+  }
+
+  bool verify(const Witness &w) const { return Folder::verify(phi, w); }
+
+  // Three-evaluation fold
+  Witness fold(const Witness &w1, const Witness &w2, const Fp2T &r) const {
+    return Folder::fold(phi, w1, w2, r);
+  }
+
+  // Committed cross terms, see CrossTermEngine
+  Terms cross_terms(const Witness &w1, const Witness &w2) const {
+    return engine.cross_terms(w1, w2);
+  }
+
+  Witness fold(const Witness &w1, const Witness &w2, const Terms &T,
+               const Fp2T &r) const {
+    return Engine::fold(w1, w2, T, r);
+  }
+
+  // k-ary fold with powers of r, see CrossTermEngine::cross_terms_many
+  MultiTerms cross_terms_many(const Witness &acc,
+                              const std::vector<Witness> &fresh) const {
+    return engine.cross_terms_many(acc, fresh);
+  }
+
+  Witness fold_many(const Witness &acc, const std::vector<Witness> &fresh,
+                    const MultiTerms &T, const Fp2T &r) const {
+    return Engine::fold_many(acc, fresh, T, r);
+  }
+
+  // The curves behind a witness
+  Fp2T j_start(const Witness &w) const {
+    return Family::j_invariant(w.j_start);
+  }
+  Fp2T j_end(const Witness &w) const { return Family::j_invariant(w.j_end); }
+};
+
+} // namespace crypto
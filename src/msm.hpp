@@ -0,0 +1,168 @@
+#pragma once
+
+#include "bigint.hpp"
+#include "edwards_fast.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+
+// Pippenger (bucket) multi-scalar multiplication sum k_i P_i on
+// TwistedEdwardsFast
+// The scalars are cut into windows of c bits, recoded to signed digits in
+// (-2^(c-1), 2^(c-1)] (a digit above half borrows 2^c from the next window),
+// so a window needs 2^(c-1) buckets and a negative digit adds -P_i, which is
+// free on Edwards curves. Per window: one addition per point into its bucket,
+// then the running-sum pass sum_j j B_j (two additions per bucket); the
+// windows are combined with c doublings each, top down.
+//
+// Cost is about (b + 1) / c * (n + 2^c) additions for b-bit scalars; window()
+// picks the c in [1, MAX_WINDOW] that minimises it, from the longest scalar
+// actually passed in, so 64-bit scalars get fewer windows than full-width
+// ones. MAX_WINDOW bounds the bucket array (2^15 points, 14 MB).
+//
+// With a ThreadPool the windows are accumulated in parallel. When there are
+// fewer windows than threads, each window's points are also split into parts
+// with their own buckets: the bucket pass is linear, so the window sum is the
+// sum of the parts' sums. The result does not depend on the pool size.
+template <typename Config> class PippengerMSM {
+  using Fp2T = Fp2<Config>;
+
+public:
+  using Curve = TwistedEdwardsFast<Config>;
+  using Point = typename Curve::Point;
+  using Scalar = BigInt<Config::N_LIMBS>;
+
+  static constexpr int MAX_WINDOW = 16;
+
+  // Window width minimising the addition count for n scalars of `bits` bits
+  static int window(size_t n, size_t bits) {
+    int best = 1;
+    double best_cost = 0;
+    for (int c = 1; c <= MAX_WINDOW; ++c) {
+      double windows = (double)((bits + 1 + c - 1) / c);
+      double cost = windows * ((double)n + (double)((size_t)1 << c));
+      if (c == 1 || cost < best_cost) {
+        best = c;
+        best_cost = cost;
+      }
+    }
+    return best;
+  }
+
+  // sum scalars[i] bases[i]; c = 0 picks the window with window()
+  static Point Mul(const Curve &curve, const Point *bases,
+                   const Scalar *scalars, size_t n, ThreadPool *pool = nullptr,
+                   int c = 0) {
+    size_t bits = 0;
+    for (size_t i = 0; i < n; ++i)
+      bits = std::max(bits, scalars[i].bit_length());
+    if (bits == 0)
+      return Point::identity();
+    if (c <= 0)
+      c = window(n, bits);
+    c = std::min(c, MAX_WINDOW);
+
+    // windows * c > bits, so the top window never borrows
+    const size_t windows = (bits + 1 + c - 1) / c;
+    size_t parts = 1;
+    if (pool && pool->size() > windows) {
+      parts = (pool->size() + windows - 1) / windows;
+      // a part with fewer points than buckets costs more than it saves
+      parts = std::max<size_t>(1, std::min(parts, n >> (c - 1)));
+    }
+
+    std::vector<Point> sums(windows * parts);
+    auto task = [&](size_t t) {
+      size_t w = t / parts, part = t % parts;
+      size_t lo = n * part / parts, hi = n * (part + 1) / parts;
+      sums[t] = window_sum(curve, bases, scalars, lo, hi, w, c);
+    };
+    if (pool)
+      pool->parallel_for(sums.size(), task);
+    else
+      for (size_t t = 0; t < sums.size(); ++t)
+        task(t);
+
+    Point R = Point::identity();
+    for (size_t w = windows; w-- > 0;) {
+      if (w + 1 < windows)
+        for (int k = 0; k < c; ++k)
+          R = curve.Double(R);
+      for (size_t part = 0; part < parts; ++part)
+        R = curve.Add(R, sums[w * parts + part]);
+    }
+    return R;
+  }
+
+  static Point Mul(const Curve &curve, const std::vector<Point> &bases,
+                   const std::vector<Scalar> &scalars,
+                   ThreadPool *pool = nullptr, int c = 0) {
+    return Mul(curve, bases.data(), scalars.data(),
+               std::min(bases.size(), scalars.size()), pool, c);
+  }
+
+  // The n independent double-and-add multiplications Mul replaces, for
+  // comparison
+  static Point MulNaive(const Curve &curve, const Point *bases,
+                        const Scalar *scalars, size_t n) {
+    Point R = Point::identity();
+    for (size_t i = 0; i < n; ++i)
+      R = curve.Add(R, curve.ScalarMul(bases[i], scalars[i]));
+    return R;
+  }
+
+  // Signed digit of window w: the c raw bits plus the borrow from window
+  // w - 1. That borrow is set when the raw bits below exceed half; they only
+  // pass the question further down when they are exactly half.
+  static int64_t digit(const Scalar &k, size_t w, int c) {
+    const uint64_t half = 1ULL << (c - 1);
+    uint64_t carry = 0;
+    for (size_t v = w; v-- > 0;) {
+      uint64_t raw = k.get_bits(v * c, c);
+      if (raw != half) {
+        carry = raw > half;
+        break;
+      }
+    }
+    int64_t d = (int64_t)(k.get_bits(w * c, c) + carry);
+    return d > (int64_t)half ? d - ((int64_t)1 << c) : d;
+  }
+
+private:
+  // sum over i in [lo, hi) of digit_w(k_i) P_i
+  static Point window_sum(const Curve &curve, const Point *bases,
+                          const Scalar *scalars, size_t lo, size_t hi,
+                          size_t w, int c) {
+    const size_t B = (size_t)1 << (c - 1);
+    std::vector<Point> buckets(B);
+    std::vector<uint8_t> used(B, 0);
+    for (size_t i = lo; i < hi; ++i) {
+      int64_t d = digit(scalars[i], w, c);
+      if (d == 0)
+        continue;
+      size_t j = (size_t)(d > 0 ? d : -d) - 1;
+      Point P = d > 0 ? bases[i] : Curve::Negate(bases[i]);
+      buckets[j] = used[j] ? curve.Add(buckets[j], P) : P;
+      used[j] = 1;
+    }
+
+    // sum_j (j + 1) buckets[j] as a sum of suffix sums
+    Point running = Point::identity(), total = Point::identity();
+    bool any = false;
+    for (size_t j = B; j-- > 0;) {
+      if (used[j]) {
+        running = any ? curve.Add(running, buckets[j]) : buckets[j];
+        any = true;
+      }
+      if (any)
+        total = curve.Add(total, running);
+    }
+    return total;
+  }
+};
+
+} // namespace crypto
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "fp2.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace crypto {
+
+// Bounded LRU cache of univariate specialisations Phi(j, Y)
+// Folding streams revisit the same j constantly: fresh witnesses come from a
+// small set of edges, and the accumulator's Phi(w_new) of one fold is the
+// Phi(w1) of the next. For a cached j,
+//
+//   Phi(j, y) = sum_i a_i y^i,   a_i = sum_k c_ik j^k,
+//
+// is a single Horner pass of degree deg_y. A miss builds the a_i from the
+// powers j^0 .. j^deg_x (one pass over the nonzero coefficients) and
+// evicts the least recently used entry once capacity is reached.
+// When Phi is symmetric, Phi(x, y) is also served from an entry for y.
+// Not thread-safe: eval() updates the recency list and the counters.
+template <typename Config> class PhiSpecializationCache {
+  using Fp2T = Fp2<Config>;
+
+  struct Entry {
+    Fp2T j;
+    std::vector<Fp2T> a; // a[i] is the coefficient of Y^i in Phi(j, Y)
+  };
+
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+
+  BivariatePoly<Fp2T> phi;
+  size_t capacity;
+
+  // Counters since construction or the last reset_stats()
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+
+  explicit PhiSpecializationCache(const BivariatePoly<Fp2T> &phi,
+                                  size_t capacity = DEFAULT_CAPACITY)
+      : phi(phi), capacity(capacity ? capacity : 1) {
+    index.reserve(this->capacity);
+  }
+
+  // index holds iterators into lru
+  PhiSpecializationCache(const PhiSpecializationCache &) = delete;
+  PhiSpecializationCache &operator=(const PhiSpecializationCache &) = delete;
+
+  Fp2T eval(const Fp2T &x, const Fp2T &y) {
+    if (const Entry *e = lookup(x)) {
+      ++hits;
+      return horner(*e, y);
+    }
+    if (phi.symmetric) {
+      if (const Entry *e = lookup(y)) {
+        ++hits;
+        return horner(*e, x);
+      }
+    }
+    ++misses;
+    return horner(insert(x), y);
+  }
+
+  // Phi(j, Y) as coefficients of Y^0 .. Y^deg_y (loaded on a miss)
+  const std::vector<Fp2T> &specialize(const Fp2T &j) {
+    if (const Entry *e = lookup(j)) {
+      ++hits;
+      return e->a;
+    }
+    ++misses;
+    return insert(j).a;
+  }
+
+  size_t size() const { return lru.size(); }
+
+  double hit_rate() const {
+    uint64_t total = hits + misses;
+    return total ? (double)hits / (double)total : 0.0;
+  }
+
+  void reset_stats() { hits = misses = evictions = 0; }
+
+  void clear() {
+    lru.clear();
+    index.clear();
+  }
+
+private:
+  // Most recently used first
+  std::list<Entry> lru;
+  std::unordered_map<Fp2T, typename std::list<Entry>::iterator,
+                     Fp2Hash<Config>, Fp2Equal<Config>>
+      index;
+
+  const Entry *lookup(const Fp2T &j) {
+    auto it = index.find(j);
+    if (it == index.end())
+      return nullptr;
+    lru.splice(lru.begin(), lru, it->second);
+    return &*it->second;
+  }
+
+  const Entry &insert(const Fp2T &j) {
+    if (lru.size() >= capacity) {
+      index.erase(lru.back().j);
+      lru.pop_back();
+      ++evictions;
+    }
+
+    lru.push_front(Entry{j, std::vector<Fp2T>(phi.deg_y + 1, Fp2T::zero())});
+    Entry &e = lru.front();
+    index.emplace(j, lru.begin());
+
+    std::vector<Fp2T> jpow(phi.deg_x + 1);
+    jpow[0] = Fp2T::one();
+    for (size_t k = 1; k <= phi.deg_x; ++k)
+      jpow[k] = Fp2T::mul(jpow[k - 1], j);
+    for (size_t i = 0; i <= phi.deg_y; ++i)
+      for (size_t k = 0; k <= phi.deg_x; ++k) {
+        const Fp2T &c = phi.coeff(k, i);
+        if (!c.is_zero())
+          e.a[i] = Fp2T::add(e.a[i], Fp2T::mul(c, jpow[k]));
+      }
+    return e;
+  }
+
+  static Fp2T horner(const Entry &e, const Fp2T &y) {
+    Fp2T res = e.a.back();
+    for (size_t i = e.a.size() - 1; i-- > 0;)
+      res = Fp2T::add(Fp2T::mul(res, y), e.a[i]);
+    return res;
+  }
+};
+
+} // namespace crypto
@@ -1,18 +1,29 @@
 #pragma once
 
 #include "fp2.hpp"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <vector>
 
 namespace crypto {
 
+template <typename CoeffT> class SubproductTree;
+
 template <typename CoeffT> class Polynomial {
 public:
   std::vector<CoeffT> coeffs; // coeffs[i] is coefficient of x^i
 
+  // Crossovers for the subquadratic paths. Tuned with the POLY benchmarks in
+  // benchmark_isogeny.cpp on Params434: an Fp2 multiplication costs far more
+  // than the extra additions, so Karatsuba already wins at 4 coefficients.
+  static constexpr size_t KARATSUBA_THRESHOLD = 4;
+  static constexpr size_t FAST_DIV_THRESHOLD = 32;    // Newton division
+  static constexpr size_t INTERP_TREE_THRESHOLD = 16; // subproduct tree
+
   Polynomial() {}
   Polynomial(const std::vector<CoeffT> &c) : coeffs(c) {}
+  Polynomial(std::vector<CoeffT> &&c) : coeffs(std::move(c)) {}
   Polynomial(size_t degree) : coeffs(degree + 1) {}
 
   // Initialize with single coefficient (constant polynomial)
@@ -85,86 +96,462 @@ public:
   static Polynomial mul(const Polynomial &a, const Polynomial &b) {
     if (a.coeffs.empty() || b.coeffs.empty())
       return Polynomial();
-    size_t deg_a = a.coeffs.size() - 1;
-    size_t deg_b = b.coeffs.size() - 1;
-    std::vector<CoeffT> res_coeffs(deg_a + deg_b + 1); // Zero init
-
-    for (size_t i = 0; i <= deg_a; ++i) {
-      for (size_t j = 0; j <= deg_b; ++j) {
-        CoeffT term = CoeffT::mul(a.coeffs[i], b.coeffs[j]);
-        res_coeffs[i + j] = CoeffT::add(res_coeffs[i + j], term);
+    std::vector<CoeffT> res_coeffs(a.coeffs.size() + b.coeffs.size() - 1);
+    mul_into(a.coeffs.data(), a.coeffs.size(), b.coeffs.data(),
+             b.coeffs.size(), res_coeffs.data());
+    return Polynomial(std::move(res_coeffs));
+  }
+
+  // out[0 .. na+nb-1) = a * b (overwritten). na, nb >= 1.
+  static void mul_schoolbook(const CoeffT *a, size_t na, const CoeffT *b,
+                             size_t nb, CoeffT *out) {
+    std::fill(out, out + na + nb - 1, CoeffT::zero());
+    for (size_t i = 0; i < na; ++i) {
+      if (a[i].is_zero())
+        continue;
+      for (size_t j = 0; j < nb; ++j)
+        out[i + j] = CoeffT::add(out[i + j], CoeffT::mul(a[i], b[j]));
+    }
+  }
+
+  // out[0 .. na+nb-1) = a * b (overwritten). na, nb >= 1.
+  // Karatsuba once both operands reach KARATSUBA_THRESHOLD; a much longer
+  // operand is cut into blocks the size of the shorter one first.
+  static void mul_into(const CoeffT *a, size_t na, const CoeffT *b, size_t nb,
+                       CoeffT *out) {
+    if (na < nb) {
+      std::swap(a, b);
+      std::swap(na, nb);
+    }
+    if (nb < KARATSUBA_THRESHOLD) {
+      mul_schoolbook(a, na, b, nb, out);
+      return;
+    }
+
+    if (na >= 2 * nb) {
+      std::fill(out, out + na + nb - 1, CoeffT::zero());
+      std::vector<CoeffT> block(2 * nb - 1);
+      for (size_t off = 0; off < na; off += nb) {
+        size_t len = std::min(nb, na - off);
+        mul_into(a + off, len, b, nb, block.data());
+        for (size_t i = 0; i < len + nb - 1; ++i)
+          out[off + i] = CoeffT::add(out[off + i], block[i]);
       }
+      return;
     }
-    return Polynomial(res_coeffs);
+
+    // nb <= na < 2 nb: split both at m = na/2, so b1 is never empty.
+    // a*b = z0 + x^m (z1 - z0 - z2) + x^2m z2 with z1 = (a0+a1)(b0+b1)
+    size_t m = na / 2, ha = na - m, hb = nb - m;
+    size_t hs = std::max(m, hb); // length of b0 + b1 (a0 + a1 has ha >= m)
+
+    mul_into(a, m, b, m, out);                      // z0 -> out[0, 2m-1)
+    out[2 * m - 1] = CoeffT::zero();
+    mul_into(a + m, ha, b + m, hb, out + 2 * m);    // z2 -> out[2m, na+nb-1)
+
+    std::vector<CoeffT> sa(a + m, a + na), sb(hs, CoeffT::zero());
+    for (size_t i = 0; i < m; ++i)
+      sa[i] = CoeffT::add(sa[i], a[i]);
+    for (size_t i = 0; i < m; ++i)
+      sb[i] = b[i];
+    for (size_t i = 0; i < hb; ++i)
+      sb[i] = CoeffT::add(sb[i], b[m + i]);
+
+    std::vector<CoeffT> z1(ha + hs - 1);
+    mul_into(sa.data(), ha, sb.data(), hs, z1.data());
+    for (size_t i = 0; i < 2 * m - 1; ++i)
+      z1[i] = CoeffT::sub(z1[i], out[i]);
+    for (size_t i = 0; i < ha + hb - 1; ++i)
+      z1[i] = CoeffT::sub(z1[i], out[2 * m + i]);
+    for (size_t i = 0; i < z1.size(); ++i)
+      out[m + i] = CoeffT::add(out[m + i], z1[i]);
+  }
+
+  // prod (X - r_i), multiplied as a balanced tree so Karatsuba applies
+  static Polynomial from_roots(const std::vector<CoeffT> &roots) {
+    if (roots.empty())
+      return Polynomial(CoeffT::mont_one());
+    return from_roots(roots.data(), roots.size());
+  }
+
+  // Formal derivative
+  static Polynomial derivative(const Polynomial &a) {
+    if (a.coeffs.size() < 2)
+      return Polynomial();
+    std::vector<CoeffT> d(a.coeffs.size() - 1);
+    CoeffT k = CoeffT::zero();
+    for (size_t i = 1; i < a.coeffs.size(); ++i) {
+      k = CoeffT::add(k, CoeffT::mont_one());
+      d[i - 1] = CoeffT::mul(k, a.coeffs[i]);
+    }
+    return Polynomial(std::move(d));
+  }
+
+  // g with a * g = 1 mod X^n, by Newton iteration (precision doubles each
+  // step). a[0] must be invertible.
+  static Polynomial inv_series(const Polynomial &a, size_t n) {
+    assert(!a.coeffs.empty() && !a.coeffs[0].is_zero());
+    const CoeffT &a0 = a.coeffs[0];
+    std::vector<CoeffT> g(
+        1, CoeffT::equal(a0, CoeffT::mont_one()) ? a0 : CoeffT::inv(a0));
+    std::vector<CoeffT> e, t;
+    for (size_t k = 1; k < n;) {
+      size_t k2 = std::min(2 * k, n);
+      // e = a * g mod X^k2 = 1 + X^k h
+      size_t na = std::min(a.coeffs.size(), k2);
+      e.resize(na + g.size() - 1);
+      mul_into(a.coeffs.data(), na, g.data(), g.size(), e.data());
+      e.resize(k2, CoeffT::zero());
+      // g <- g - X^k (g h) mod X^k2
+      t.resize(g.size() + (k2 - k) - 1);
+      mul_into(g.data(), g.size(), e.data() + k, k2 - k, t.data());
+      g.resize(k2);
+      for (size_t i = 0; i < k2 - k; ++i)
+        g[k + i] = CoeffT::sub(CoeffT::zero(), t[i]);
+      k = k2;
+    }
+    return Polynomial(std::move(g));
+  }
+
+  // --- Euclidean arithmetic (coefficients must be a field) ---
+
+  bool is_zero() const {
+    for (auto &c : coeffs)
+      if (!c.is_zero())
+        return false;
+    return true;
+  }
+
+  // Strip trailing zero coefficients; the zero polynomial becomes empty
+  void normalize() {
+    while (!coeffs.empty() && coeffs.back().is_zero())
+      coeffs.pop_back();
+  }
+
+  // Degree of a normalized polynomial, -1 for zero
+  int deg() const { return (int)coeffs.size() - 1; }
+
+  static Polynomial monic(const Polynomial &a) {
+    Polynomial r = a;
+    r.normalize();
+    if (r.coeffs.empty())
+      return r;
+    CoeffT lc_inv = CoeffT::inv(r.coeffs.back());
+    for (auto &c : r.coeffs)
+      c = CoeffT::mul(c, lc_inv);
+    return r;
+  }
+
+  // a = q * b + r with deg r < deg b. b must be nonzero.
+  static void divmod(const Polynomial &a, const Polynomial &b, Polynomial &q,
+                     Polynomial &r) {
+    Polynomial bn = b;
+    bn.normalize();
+    assert(!bn.coeffs.empty());
+    r = a;
+    r.normalize();
+    int db = bn.deg();
+    if (r.deg() < db) {
+      q = Polynomial();
+      return;
+    }
+    if ((size_t)db >= FAST_DIV_THRESHOLD &&
+        (size_t)(r.deg() - db) >= FAST_DIV_THRESHOLD) {
+      divmod_newton(r, bn, q);
+      return;
+    }
+    q.coeffs.assign(r.deg() - db + 1, CoeffT::zero());
+    // Monic divisors (every subproduct tree node) skip the inversion
+    const CoeffT &lc = bn.coeffs.back();
+    CoeffT lc_inv =
+        CoeffT::equal(lc, CoeffT::mont_one()) ? lc : CoeffT::inv(lc);
+    for (int k = r.deg() - db; k >= 0; --k) {
+      CoeffT t = CoeffT::mul(r.coeffs[k + db], lc_inv);
+      q.coeffs[k] = t;
+      if (t.is_zero())
+        continue;
+      for (int j = 0; j <= db; ++j)
+        r.coeffs[k + j] =
+            CoeffT::sub(r.coeffs[k + j], CoeffT::mul(t, bn.coeffs[j]));
+    }
+    r.coeffs.resize(db);
+    r.normalize();
+  }
+
+  static Polynomial mod(const Polynomial &a, const Polynomial &b) {
+    Polynomial q, r;
+    divmod(a, b, q, r);
+    return r;
+  }
+
+  // Monic gcd (zero if both inputs are zero)
+  static Polynomial gcd(const Polynomial &a, const Polynomial &b) {
+    Polynomial x = a, y = b;
+    x.normalize();
+    y.normalize();
+    while (!y.coeffs.empty()) {
+      Polynomial r = mod(x, y);
+      x = y;
+      y = r;
+    }
+    return monic(x);
+  }
+
+  static Polynomial mulmod(const Polynomial &a, const Polynomial &b,
+                           const Polynomial &m) {
+    return mod(mul(a, b), m);
+  }
+
+  // base^e mod m, left-to-right square-and-multiply
+  template <typename Exp>
+  static Polynomial powmod(const Polynomial &base, const Exp &e,
+                           const Polynomial &m) {
+    Polynomial res = mod(Polynomial(CoeffT::mont_one()), m);
+    Polynomial b = mod(base, m);
+    for (int i = (int)e.bit_length() - 1; i >= 0; --i) {
+      res = mulmod(res, res, m);
+      if (e.get_bit(i))
+        res = mulmod(res, b, m);
+    }
+    return res;
   }
 
-  // Lagrange Interpolation
-  // Points: (x, y) pairs
+  // Interpolation through (x, y) pairs with distinct x.
+  // Large inputs go through a subproduct tree (O(M(n) log n)); small ones use
+  // the quadratic Lagrange form below.
   static Polynomial
   interpolate(const std::vector<std::pair<CoeffT, CoeffT>> &points) {
+    if (points.size() < INTERP_TREE_THRESHOLD)
+      return interpolate_lagrange(points);
+    std::vector<CoeffT> xs, ys;
+    for (auto &pt : points) {
+      xs.push_back(pt.first);
+      ys.push_back(pt.second);
+    }
+    SubproductTree<CoeffT> tree(xs);
+    return tree.interpolate(ys);
+  }
+
+  // Lagrange Interpolation, O(n^2)
+  // M(x) = prod (x - x_j) is built once; each basis numerator M / (x - x_i)
+  // is one synthetic division. The denominators M'(x_i) are inverted in one
+  // batch (Montgomery's trick), so the whole thing costs a single inversion.
+  static Polynomial
+  interpolate_lagrange(const std::vector<std::pair<CoeffT, CoeffT>> &points) {
     if (points.empty())
       return Polynomial();
 
-    Polynomial result; // 0
-    // Needs proper identity initialization for CoeffT (1 and 0)
-    // We can extract 0 and 1 from the first point's types usually, or passed
-    // in. Assuming CoeffT has static methods or we construct from scratch.
-    // Actually, let's use the first point to allow generating 0/1.
-    CoeffT one = CoeffT::mont_one(); // Assuming Fp/Fp2 interface
-    CoeffT zero = CoeffT::zero();
+    size_t n = points.size();
+    std::vector<CoeffT> xs(n);
+    for (size_t i = 0; i < n; ++i)
+      xs[i] = points[i].first;
+    Polynomial M = from_roots(xs); // degree n, monic
+    Polynomial dM = derivative(M);
 
-    result = Polynomial(zero);
+    // factor_i = y_i / M'(x_i)
+    std::vector<CoeffT> factor(n), prefix(n);
+    CoeffT acc = CoeffT::mont_one();
+    for (size_t i = 0; i < n; ++i) {
+      factor[i] = dM.eval(xs[i]);
+      prefix[i] = acc;
+      acc = CoeffT::mul(acc, factor[i]);
+    }
+    CoeffT inv = CoeffT::inv(acc);
+    for (size_t i = n; i-- > 0;) {
+      CoeffT inv_i = CoeffT::mul(inv, prefix[i]);
+      inv = CoeffT::mul(inv, factor[i]);
+      factor[i] = CoeffT::mul(points[i].second, inv_i);
+    }
 
-    for (size_t i = 0; i < points.size(); ++i) {
-      CoeffT xi = points[i].first;
-      CoeffT yi = points[i].second;
+    std::vector<CoeffT> result(n, CoeffT::zero());
+    std::vector<CoeffT> Li(n);
+    for (size_t i = 0; i < n; ++i) {
+      // Li = M / (x - x_i): synthetic division from the top
+      Li[n - 1] = M.coeffs[n];
+      for (size_t k = n - 1; k > 0; --k)
+        Li[k - 1] = CoeffT::add(M.coeffs[k], CoeffT::mul(Li[k], xs[i]));
+      for (size_t k = 0; k < n; ++k)
+        result[k] = CoeffT::add(result[k], CoeffT::mul(Li[k], factor[i]));
+    }
 
-      // L_i(x) = product_{j!=i} (x - xj) / (xi - xj)
-      Polynomial Li(one);
-      CoeffT den = one;
+    // Same shape as before: trailing zeros stripped, at least one coefficient
+    while (result.size() > 1 && result.back().is_zero())
+      result.pop_back();
+    return Polynomial(std::move(result));
+  }
 
-      for (size_t j = 0; j < points.size(); ++j) {
-        if (i == j)
-          continue;
-        CoeffT xj = points[j].first;
+  // Print helper
+  void print(const std::string &name, std::ostream &os = std::cout) const {
+    os << name << "(X) = ";
+    for (int i = 0; i < coeffs.size(); ++i) {
+      if (i > 0)
+        os << " + ";
+      os << "(";
+      coeffs[i].print(os); // Assuming CoeffT has print
+      os << ")*X^" << i;
+    }
+    os << std::endl;
+  }
 
-        // num = (x - xj)
-        Polynomial term = Polynomial::x(one, zero); // x
-        Polynomial const_xj(xj);
-        term = sub(term, const_xj); // x - xj
 
-        Li = mul(Li, term);
+private:
+  static Polynomial from_roots(const CoeffT *roots, size_t n) {
+    if (n == 1) {
+      std::vector<CoeffT> c = {CoeffT::sub(CoeffT::zero(), roots[0]),
+                               CoeffT::mont_one()};
+      return Polynomial(std::move(c));
+    }
+    return mul(from_roots(roots, n / 2), from_roots(roots + n / 2, n - n / 2));
+  }
 
-        // den = den * (xi - xj)
-        CoeffT diff = CoeffT::sub(xi, xj);
-        den = CoeffT::mul(den, diff);
-      }
+  // q = a div b via reversed polynomials: rev(q) = rev(a) / rev(b) mod
+  // X^(deg a - deg b + 1); then a <- a - q b. a, b normalized, deg a >= deg b.
+  static void divmod_newton(Polynomial &a, const Polynomial &b, Polynomial &q) {
+    size_t da = a.deg(), db = b.deg(), nq = da - db + 1;
+    Polynomial ra, rb;
+    ra.coeffs.assign(a.coeffs.rbegin(), a.coeffs.rbegin() + nq);
+    rb.coeffs.assign(b.coeffs.rbegin(),
+                     b.coeffs.rbegin() + std::min(nq, db + 1));
+    Polynomial inv_rb = inv_series(rb, nq);
+    std::vector<CoeffT> rq(nq + nq - 1);
+    mul_into(ra.coeffs.data(), nq, inv_rb.coeffs.data(), nq, rq.data());
+    q.coeffs.assign(rq.rend() - nq, rq.rend());
+
+    // Only the low db coefficients of a - q b survive
+    size_t nlo = std::min(nq, db);
+    std::vector<CoeffT> qb(nlo + db - 1);
+    if (nlo > 0) {
+      mul_into(q.coeffs.data(), nlo, b.coeffs.data(), db, qb.data());
+    }
+    a.coeffs.resize(db);
+    for (size_t i = 0; i < db; ++i)
+      a.coeffs[i] = CoeffT::sub(a.coeffs[i], qb[i]);
+    a.normalize();
+  }
+};
 
-      // Li = Li * yi / den
-      CoeffT den_inv = CoeffT::inv(den);
-      CoeffT factor = CoeffT::mul(yi, den_inv);
+// Subproduct tree over points x_0 .. x_{n-1}:
+//   level 0:  X - x_i
+//   level k:  products of adjacent pairs of level k-1 (an odd node out moves
+//             up unchanged), so node i of level k covers points
+//             [i 2^k, (i+1) 2^k)
+//   top:      M(X) = prod (X - x_i)
+// Going down the tree with remainders evaluates a polynomial at every point
+// in O(M(n) log n); going up with linear combinations interpolates.
+template <typename CoeffT> class SubproductTree {
+  using Poly = Polynomial<CoeffT>;
 
-      // Multiply poly by scalar
-      for (auto &c : Li.coeffs) {
-        c = CoeffT::mul(c, factor);
+public:
+  std::vector<CoeffT> points;
+  std::vector<std::vector<Poly>> levels;
+
+  explicit SubproductTree(const std::vector<CoeffT> &xs) : points(xs) {
+    std::vector<Poly> leaves;
+    for (auto &x : xs) {
+      std::vector<CoeffT> c = {CoeffT::sub(CoeffT::zero(), x),
+                               CoeffT::mont_one()};
+      leaves.push_back(Poly(std::move(c)));
+    }
+    if (leaves.empty())
+      leaves.push_back(Poly(CoeffT::mont_one()));
+    levels.push_back(std::move(leaves));
+    while (levels.back().size() > 1) {
+      const std::vector<Poly> &prev = levels.back();
+      std::vector<Poly> next;
+      for (size_t i = 0; i < prev.size(); i += 2)
+        next.push_back(i + 1 < prev.size() ? Poly::mul(prev[i], prev[i + 1])
+                                           : prev[i]);
+      levels.push_back(std::move(next));
+    }
+  }
+
+  const Poly &root() const { return levels.back()[0]; }
+
+  // f(x_i) for every point
+  std::vector<CoeffT> evaluate(const Poly &f) const {
+    std::vector<CoeffT> out(points.size(), CoeffT::zero());
+    if (!points.empty())
+      evaluate_node(Poly::mod(f, root()), levels.size() - 1, 0, out);
+    return out;
+  }
+
+  // Computes the interpolation weights now instead of on the first
+  // interpolate(). Afterwards interpolate() only reads the tree, so it may be
+  // called from several threads at once. false if two points coincide.
+  bool prepare_interpolation() {
+    return !inv_weights.empty() || compute_weights();
+  }
+
+  // The polynomial of degree < n through (x_i, ys[i]). Returns the zero
+  // polynomial (and complains) when two points coincide.
+  // The weights 1 / M'(x_i) depend only on the points, so they are computed
+  // on first use and shared by every later call on the same tree.
+  Poly interpolate(const std::vector<CoeffT> &ys) {
+    if (points.empty())
+      return Poly();
+    if (!prepare_interpolation()) {
+      std::cerr << "SubproductTree::interpolate: repeated x" << std::endl;
+      return Poly();
+    }
+    std::vector<Poly> vals(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+      vals[i] = Poly(CoeffT::mul(ys[i], inv_weights[i]));
+
+    // node = left_val * right_poly + right_val * left_poly
+    for (size_t k = 1; k < levels.size(); ++k) {
+      const std::vector<Poly> &below = levels[k - 1];
+      std::vector<Poly> up((vals.size() + 1) / 2);
+      for (size_t i = 0; i < vals.size(); i += 2) {
+        if (i + 1 == vals.size()) {
+          up[i / 2] = std::move(vals[i]);
+          continue;
+        }
+        up[i / 2] = Poly::add(Poly::mul(vals[i], below[i + 1]),
+                              Poly::mul(vals[i + 1], below[i]));
       }
+      vals = std::move(up);
+    }
+    return vals[0];
+  }
+
+private:
+  // Below this many points a node evaluates its remainder by Horner
+  static constexpr size_t HORNER_LEAVES = 8;
 
-      result = add(result, Li);
+  std::vector<CoeffT> inv_weights;
+
+  void evaluate_node(const Poly &r, size_t level, size_t index,
+                     std::vector<CoeffT> &out) const {
+    size_t lo = index << level;
+    size_t hi = std::min(points.size(), (index + 1) << level);
+    if (hi - lo <= HORNER_LEAVES || level == 0) {
+      for (size_t i = lo; i < hi; ++i)
+        out[i] = r.coeffs.empty() ? CoeffT::zero() : r.eval(points[i]);
+      return;
     }
-    return result;
+    const std::vector<Poly> &below = levels[level - 1];
+    for (size_t c = 2 * index; c < 2 * index + 2 && c < below.size(); ++c)
+      evaluate_node(Poly::mod(r, below[c]), level - 1, c, out);
   }
 
-  // Print helper
-  void print(const std::string &name) const {
-    std::cout << name << "(X) = ";
-    for (int i = 0; i < coeffs.size(); ++i) {
-      if (i > 0)
-        std::cout << " + ";
-      std::cout << "(";
-      coeffs[i].print(); // Assuming CoeffT has print
-      std::cout << ")*X^" << i;
+  bool compute_weights() {
+    std::vector<CoeffT> w = evaluate(Poly::derivative(root()));
+    // Batch inversion (Montgomery's trick)
+    std::vector<CoeffT> prefix(w.size());
+    CoeffT acc = CoeffT::mont_one();
+    for (size_t i = 0; i < w.size(); ++i) {
+      if (w[i].is_zero())
+        return false;
+      prefix[i] = acc;
+      acc = CoeffT::mul(acc, w[i]);
+    }
+    CoeffT inv = CoeffT::inv(acc);
+    inv_weights.resize(w.size());
+    for (size_t i = w.size(); i-- > 0;) {
+      inv_weights[i] = CoeffT::mul(inv, prefix[i]);
+      inv = CoeffT::mul(inv, w[i]);
     }
-    std::cout << std::endl;
+    return true;
   }
 };
 
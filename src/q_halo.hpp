@@ -1,9 +1,12 @@
 #pragma once
 
+#include "checkpoint.hpp"
 #include "commitment.hpp"
 #include "modpoly.hpp"
+#include "phi_cache.hpp"
 #include "relaxed_folding.hpp"
 #include "transcript.hpp"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -35,12 +38,34 @@ public:
     // Public (Verifier sees)
     Point C_j; // Commitment to j_acc
     Point C_u; // Commitment to u_acc
+
+    // FoldCheckpoint::extra of a checkpointed run
+    std::vector<uint8_t> encode() const {
+      std::vector<uint8_t> buf;
+      for (const Fp2T *v : {&j_acc, &u_acc, &C_j.X, &C_j.Y, &C_u.X, &C_u.Y})
+        CacheIO::put_fp2(buf, *v);
+      CacheIO::put(buf, blind_j);
+      CacheIO::put(buf, blind_u);
+      return buf;
+    }
+
+    bool decode(const std::vector<uint8_t> &buf) {
+      size_t off = 0;
+      for (Fp2T *v : {&j_acc, &u_acc, &C_j.X, &C_j.Y, &C_u.X, &C_u.Y})
+        if (!CacheIO::get_fp2(buf, off, *v))
+          return false;
+      return CacheIO::get(buf, off, blind_j) &&
+             CacheIO::get(buf, off, blind_u) && off == buf.size();
+    }
   };
 
+  // With ckpt, the accumulated state, transcript and step seed are saved on
+  // its schedule and at the end, and a run finding a checkpoint resumes from
+  // it: an interrupted run finishes with the same commitments.
   static void
   run_protocol(const std::vector<Poly> &phi_coeffs,
                const std::vector<std::pair<Fp2T, Fp2T>> &valid_pairs,
-               int num_steps) {
+               int num_steps, Checkpointer<Config> *ckpt = nullptr) {
     std::cout << "\n========================================" << std::endl;
     std::cout << "   Q-HALO PROTOCOL: SECURE RUN" << std::endl;
     std::cout << "========================================\n" << std::endl;
@@ -56,6 +81,11 @@ public:
     CommitScheme pedersen;
     Trans transcript;
 
+    // The prover checks every step is an edge before committing to it;
+    // steps repeat, so this is mostly cache hits
+    PhiSpecializationCache<Config> phi_cache(
+        BivariatePoly<Fp2T>::from_rows(phi_coeffs));
+
     // Initialize accumulator with first isogeny step
     auto p0 = valid_pairs[0];
 
@@ -73,26 +103,55 @@ public:
     transcript.Absorb(acc.j_acc);
     transcript.Absorb(acc.u_acc);
 
+    // Seed for selecting isogeny steps
+    uint64_t step_seed = 42;
+    int first_step = 0;
+
+    const auto relation = FoldCheckpoint<Config>::relation_tag(
+        "run_protocol", phi_coeffs, valid_pairs);
+    FoldCheckpoint<Config> saved;
+    if (ckpt && ckpt->load(saved, relation)) {
+      AccumulatedState restored;
+      if (restored.decode(saved.extra) && transcript.SetState(saved.sponge)) {
+        acc = restored;
+        step_seed = saved.cursor;
+        first_step = (int)saved.step;
+        std::cout << "[SETUP] Resuming from " << ckpt->path << " at step "
+                  << first_step << std::endl;
+      }
+    }
+    auto checkpoint = [&](int steps_done) {
+      FoldCheckpoint<Config> c;
+      c.relation = relation;
+      c.step = (uint64_t)steps_done;
+      c.cursor = step_seed;
+      c.sponge = transcript.GetState();
+      c.extra = acc.encode();
+      return c;
+    };
+
     std::cout << "[SETUP] Initial j_acc = ";
     acc.j_acc.print();
     std::cout << "[SETUP] Initial C_j.X = ";
     acc.C_j.X.print();
     std::cout << std::endl;
 
-    // Seed for selecting isogeny steps
-    uint64_t step_seed = 42;
-
     // 2. MAIN LOOP
     std::cout << "[LOOP] Running " << num_steps << " recursive steps..."
               << std::endl;
 
-    for (int step = 0; step < num_steps; ++step) {
+    for (int step = first_step; step < num_steps; ++step) {
       // Step A: Prover generates new isogeny step
       int idx = (step_seed >> 8) % valid_pairs.size();
       step_seed = step_seed * 6364136223846793005ULL + 1;
 
       auto p_new = valid_pairs[idx];
       Witness w_new = {p_new.first, p_new.second, Fp2T::zero()};
+      if (!Folder::verify(phi_cache, w_new)) {
+        std::cout << "ERROR: step " << step << " is not an isogeny edge."
+                  << std::endl;
+        return;
+      }
 
       // New blinding factors
       uint64_t blind_j_new = (step_seed % 17) + 1;
@@ -135,8 +194,15 @@ public:
       std::cout << "  Step " << step << ": r=1 (additive)"
                 << ", j_acc=" << (acc.j_acc.c0.val.limbs[0] % 19)
                 << ", blind=" << acc.blind_j << std::endl;
+
+      if (ckpt && ckpt->due((uint64_t)step + 1))
+        ckpt->save(checkpoint(step + 1));
     }
+    if (ckpt)
+      ckpt->save_synced(checkpoint(std::max(num_steps, first_step)));
 
+    std::cout << "[LOOP] Phi(j, Y) cache: " << phi_cache.hits << " hits, "
+              << phi_cache.misses << " misses" << std::endl;
     std::cout << std::endl;
 
     // 3. FINAL VERIFICATION
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "curve.hpp"
+#include "fp2.hpp"
+#include "relaxed_folding.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+
+// Cube roots in Fp2 (q = p^2).
+// q - 1 = 3^s * t with gcd(t, 3) = 1. For a cube a, x = a^u with
+// u = (t+1)/3 (t = 2 mod 3) or u = (2t+1)/3 (t = 1 mod 3) is a cube root up
+// to a factor in the 3-Sylow subgroup; that factor is recovered with a
+// Pohlig-Hellman discrete log against a fixed Sylow generator c.
+// For SIKE-style primes the Sylow subgroup is large (s = 137 for p434), so
+// the log costs O(s^2) cubings on top of the exponentiation.
+template <typename Config> struct Fp2CubeRoot {
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  static constexpr size_t N = Config::N_LIMBS;
+  using Wide = BigInt<2 * N>;
+
+  size_t s = 0;
+  Wide t, u, cube_exp;         // cube_exp = (q-1)/3
+  std::vector<Fp2T> c_pow;     // c^(3^i), i < s
+  std::vector<Fp2T> c_pow_inv; // c^(-3^i)
+  Fp2T omega, omega2;          // primitive cube roots of unity
+
+  Fp2CubeRoot() {
+    BigInt<N> one(1), pm1, pp1;
+    BigInt<N>::sub(pm1, Config::p(), one);
+    BigInt<N>::add(pp1, Config::p(), one);
+    Wide q1 = BigInt<N>::mul_wide(pm1, pp1);
+
+    cube_exp = q1;
+    Wide::div_word(cube_exp, 3); // p^2 = 1 mod 3 for p != 3
+
+    t = q1;
+    for (;;) {
+      Wide tmp = t;
+      if (Wide::div_word(tmp, 3) != 0)
+        break;
+      t = tmp;
+      s++;
+    }
+
+    Wide tmp = t;
+    Word t_mod3 = Wide::div_word(tmp, 3);
+    u = t;
+    if (t_mod3 == 1)
+      Wide::add(u, u, t);
+    Wide::add(u, u, Wide(1));
+    Wide::div_word(u, 3);
+
+    // Cubic non-residue z = k + i
+    Fp2T z;
+    for (uint64_t k = 1;; ++k) {
+      z = Fp2T(FpT(BigInt<N>(k)).to_montgomery(), FpT::mont_one());
+      if (!Fp2T::equal(Fp2T::pow(z, cube_exp), Fp2T::one()))
+        break;
+    }
+
+    c_pow.resize(s);
+    c_pow[0] = Fp2T::pow(z, t);
+    for (size_t i = 1; i < s; ++i)
+      c_pow[i] = cube(c_pow[i - 1]);
+    c_pow_inv = c_pow;
+    Fp2T::batch_inv(c_pow_inv.data(), s);
+
+    omega = c_pow[s - 1];
+    omega2 = Fp2T::sqr(omega);
+  }
+
+  static Fp2T cube(const Fp2T &a) { return Fp2T::mul(Fp2T::sqr(a), a); }
+
+  bool is_cube(const Fp2T &a) const {
+    return a.is_zero() || Fp2T::equal(Fp2T::pow(a, cube_exp), Fp2T::one());
+  }
+
+  // Returns false if a is not a cube.
+  bool cbrt(const Fp2T &a, Fp2T &out) const {
+    if (a.is_zero()) {
+      out = Fp2T::zero();
+      return true;
+    }
+    Fp2T x = Fp2T::pow(a, u);
+    // b = x^3 / a lies in the 3-Sylow subgroup
+    Fp2T g = Fp2T::mul(cube(x), Fp2T::inv(a));
+
+    // Digits of log_c(b) in base 3; h collects c^(-log/3)
+    Fp2T h = Fp2T::one();
+    for (size_t i = 0; i < s; ++i) {
+      Fp2T gamma = g;
+      for (size_t k = 0; k + 1 + i < s; ++k)
+        gamma = cube(gamma);
+      int d;
+      if (Fp2T::equal(gamma, Fp2T::one()))
+        d = 0;
+      else if (Fp2T::equal(gamma, omega))
+        d = 1;
+      else if (Fp2T::equal(gamma, omega2))
+        d = 2;
+      else
+        return false;
+      if (d == 0)
+        continue;
+      if (i == 0)
+        return false; // b is not a cube, so neither is a
+      for (int k = 0; k < d; ++k) {
+        g = Fp2T::mul(g, c_pow_inv[i]);
+        h = Fp2T::mul(h, c_pow_inv[i - 1]);
+      }
+    }
+    out = Fp2T::mul(x, h);
+    return Fp2T::equal(cube(out), a);
+  }
+};
+
+// Radical isogeny walker
+// Walks the l-isogeny graph for l = 2, 3, 4 without ever computing a kernel
+// point: the codomain of the next step is a rational function of an l-th
+// root of a coefficient of the current curve, and the choice of root picks a
+// non-backtracking neighbour.
+//   l = 2: Montgomery y^2 = x^3 + Ax^2 + x. The kernel is a root alpha of
+//          x^2 + Ax + 1 (one square root), codomain A' = 2 - 4 alpha^2,
+//          and the dual kernel on the codomain is (0,0).
+//   l = 4: two consecutive non-backtracking 2-steps (a cyclic 4-isogeny).
+//   l = 3: Tate normal form y^2 + a1 xy + a3 y = x^3 with (0,0) of order 3.
+//          rho^3 = -a3, a1' = a1 - 6 rho, a3' = 3 a1 rho^2 - a1^2 rho + 9 a3.
+// The walker emits consecutive (j_start, j_end) pairs as relaxed witnesses
+// with u = 0, ready for RelaxedIsogenyFolder.
+template <typename Config> class RadicalIsogenyWalker {
+public:
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  using Point = PointProj<Config>;
+  using Curve = MontgomeryCurve<Config>;
+  using Witness = typename RelaxedIsogenyFolder<Config>::RelaxedWitness;
+
+  struct TateCurve {
+    Fp2T a1, a3;
+  };
+
+  explicit RadicalIsogenyWalker(uint64_t seed = 1) : rng_state(seed) {}
+
+  static Fp2T constant(uint64_t k) {
+    return Fp2T(FpT(BigInt<Config::N_LIMBS>(k)).to_montgomery(), FpT::zero());
+  }
+
+  // --- l = 2 / l = 4 (Montgomery) ---
+
+  static bool step2(Fp2T &A, bool sign) {
+    Fp2T disc = Fp2T::sub(Fp2T::sqr(A), constant(4));
+    Fp2T sd = Fp2T::sqrt(disc);
+    if (disc.is_zero() || !Fp2T::equal(Fp2T::sqr(sd), disc))
+      return false;
+    if (sign)
+      sd = Fp2T::sub(Fp2T::zero(), sd);
+    // alpha = (-A + sd) / 2, so 4 alpha^2 = (sd - A)^2 and no inversion
+    // is needed
+    A = Fp2T::sub(constant(2), Fp2T::sqr(Fp2T::sub(sd, A)));
+    return true;
+  }
+
+  static bool step4(Fp2T &A, unsigned dir) {
+    return step2(A, dir & 1) && step2(A, (dir >> 1) & 1);
+  }
+
+  // j = 256 (A^2 - 3)^3 / (A^2 - 4), returned as a fraction
+  static void j_fraction(const Fp2T &A, Fp2T &num, Fp2T &den) {
+    Fp2T A2 = Fp2T::sqr(A);
+    Fp2T t = Fp2T::sub(A2, constant(3));
+    num = Fp2T::mul(Fp2T::mul(Fp2T::sqr(t), t), constant(256));
+    den = Fp2T::sub(A2, constant(4));
+  }
+
+  // --- l = 3 (Tate normal form) ---
+
+  // Finds an order-3 point on (A, 1) by clearing the cofactor (p+1)/3.
+  // Only valid for supersingular curves with #E(Fp2) = (p+1)^2.
+  bool find_order3_x(const Fp2T &A, Fp2T &x3) {
+    BigInt<Config::N_LIMBS> cof;
+    BigInt<Config::N_LIMBS>::add(cof, Config::p(), BigInt<Config::N_LIMBS>(1));
+    if (BigInt<Config::N_LIMBS>::div_word(cof, 3) != 0)
+      return false; // no rational 3-torsion
+    Fp2T C = Fp2T::one();
+    for (int tries = 0; tries < 64; ++tries) {
+      Point P{Fp2T(FpT(BigInt<Config::N_LIMBS>(next() >> 8)).to_montgomery(),
+                   FpT(BigInt<Config::N_LIMBS>(next() >> 8)).to_montgomery()),
+              Fp2T::one()};
+      Point Q = Curve::xMUL(P, cof, A, C);
+      if (Q.Z.is_zero())
+        continue;
+      Point R = Curve::xMUL(Q, BigInt<Config::N_LIMBS>(3), A, C);
+      if (!R.Z.is_zero())
+        continue; // P was on the twist
+      x3 = Fp2T::mul(Q.X, Fp2T::inv(Q.Z));
+      return true;
+    }
+    return false;
+  }
+
+  // Moves (x3, y3) on y^2 = x^3 + Ax^2 + x to (0,0) and takes the tangent
+  // there (a flex, since the point has order 3) as the new x-axis.
+  // If y3 is not rational we use the quadratic twist by d = x3^3 + A x3^2 + x3,
+  // which has the same j-invariant.
+  static bool to_tate(const Fp2T &A, const Fp2T &x3, TateCurve &out) {
+    Fp2T x2 = Fp2T::sqr(x3);
+    Fp2T rhs = Fp2T::add(Fp2T::mul(Fp2T::add(x3, A), x2), x3);
+    if (rhs.is_zero())
+      return false;
+    Fp2T a2 = A, a4 = Fp2T::one(), x = x3, y;
+    if (Fp2T::is_square(rhs)) {
+      y = Fp2T::sqrt(rhs);
+    } else {
+      a2 = Fp2T::mul(rhs, A);
+      a4 = Fp2T::sqr(rhs);
+      x = Fp2T::mul(rhs, x3);
+      y = a4;
+      x2 = Fp2T::sqr(x);
+    }
+    // lambda = (3x^2 + 2 a2 x + a4) / (2y)
+    Fp2T num = Fp2T::add(Fp2T::mul(constant(3), x2),
+                         Fp2T::add(Fp2T::mul(constant(2), Fp2T::mul(a2, x)), a4));
+    Fp2T two_y = Fp2T::add(y, y);
+    Fp2T lambda = Fp2T::mul(num, Fp2T::inv(two_y));
+    out.a1 = Fp2T::add(lambda, lambda);
+    out.a3 = two_y;
+    return true;
+  }
+
+  bool step3(TateCurve &E, unsigned dir) const {
+    Fp2T rho;
+    if (!cube_root.cbrt(Fp2T::sub(Fp2T::zero(), E.a3), rho))
+      return false;
+    if (dir % 3 == 1)
+      rho = Fp2T::mul(rho, cube_root.omega);
+    else if (dir % 3 == 2)
+      rho = Fp2T::mul(rho, cube_root.omega2);
+
+    Fp2T a1 = E.a1, a3 = E.a3;
+    Fp2T rho2 = Fp2T::sqr(rho);
+    E.a1 = Fp2T::sub(a1, Fp2T::mul(constant(6), rho));
+    Fp2T t0 = Fp2T::mul(constant(3), Fp2T::mul(a1, rho2));
+    Fp2T t1 = Fp2T::mul(Fp2T::sqr(a1), rho);
+    E.a3 = Fp2T::add(Fp2T::sub(t0, t1), Fp2T::mul(constant(9), a3));
+    return true;
+  }
+
+  // j = a1^3 (a1^3 - 24 a3)^3 / (a3^3 (a1^3 - 27 a3))
+  static void j_fraction(const TateCurve &E, Fp2T &num, Fp2T &den) {
+    Fp2T a13 = Fp2T::mul(Fp2T::sqr(E.a1), E.a1);
+    Fp2T t = Fp2T::sub(a13, Fp2T::mul(constant(24), E.a3));
+    num = Fp2T::mul(a13, Fp2T::mul(Fp2T::sqr(t), t));
+    Fp2T a33 = Fp2T::mul(Fp2T::sqr(E.a3), E.a3);
+    den = Fp2T::mul(a33, Fp2T::sub(a13, Fp2T::mul(constant(27), E.a3)));
+  }
+
+  // --- Walk ---
+
+  // Walks `steps` l-isogenies starting from the Montgomery curve (A0, 1).
+  // Directions come from the walker's seed. Returns one witness per step;
+  // stops early if a step fails (e.g. no rational l-torsion on the curve).
+  std::vector<Witness> walk(int l, const Fp2T &A0, size_t steps) {
+    std::vector<Fp2T> nums, dens;
+    nums.reserve(steps + 1);
+    dens.reserve(steps + 1);
+    Fp2T num, den;
+
+    if (l == 2 || l == 4) {
+      Fp2T A = A0;
+      j_fraction(A, num, den);
+      nums.push_back(num);
+      dens.push_back(den);
+      for (size_t i = 0; i < steps; ++i) {
+        unsigned dir = (unsigned)(next() >> 32);
+        bool ok = (l == 2) ? step2(A, dir & 1) : step4(A, dir);
+        if (!ok)
+          break;
+        j_fraction(A, num, den);
+        nums.push_back(num);
+        dens.push_back(den);
+      }
+    } else if (l == 3) {
+      Fp2T x3;
+      TateCurve E;
+      if (!find_order3_x(A0, x3) || !to_tate(A0, x3, E))
+        return {};
+      j_fraction(E, num, den);
+      nums.push_back(num);
+      dens.push_back(den);
+      for (size_t i = 0; i < steps; ++i) {
+        unsigned dir = (unsigned)((next() >> 32) % 3);
+        if (!step3(E, dir))
+          break;
+        j_fraction(E, num, den);
+        nums.push_back(num);
+        dens.push_back(den);
+      }
+    } else {
+      std::cerr << "RadicalIsogenyWalker: unsupported degree " << l
+                << std::endl;
+      return {};
+    }
+
+    // One inversion for the whole chain
+    Fp2T::batch_inv(dens.data(), dens.size());
+    std::vector<Fp2T> js(nums.size());
+    for (size_t i = 0; i < nums.size(); ++i)
+      js[i] = Fp2T::mul(nums[i], dens[i]);
+
+    std::vector<Witness> out;
+    out.reserve(js.size());
+    for (size_t i = 0; i + 1 < js.size(); ++i)
+      out.push_back(Witness{js[i], js[i + 1], Fp2T::zero()});
+    return out;
+  }
+
+private:
+  uint64_t rng_state;
+  Fp2CubeRoot<Config> cube_root;
+
+  uint64_t next() {
+    rng_state = rng_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return rng_state;
+  }
+};
+
+} // namespace crypto
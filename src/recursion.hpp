@@ -1,8 +1,15 @@
 
 #pragma once
 
+#include "checkpoint.hpp"
+#include "cross_terms.hpp"
+#include "edge_stream.hpp"
+#include "fold_pipeline.hpp"
 #include "relaxed_folding.hpp"
 #include "transcript.hpp" // Added for Transcript
+#include "tree_folding.hpp"
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -45,56 +52,331 @@ public:
       return Witness();
     }
 
-    // 1. Initialize Accumulator
-    auto p0 = valid_pairs[0];
-    Witness accumulator = {p0.first, p0.second, Fp2T::zero()};
-
-    // 2. Initialize Transcript
-    Transcript transcript;
-    transcript.Absorb(accumulator); // Bind initial state
-
     // Seed for choosing steps (this remains random/external, as the Prover
     // chooses the path) But the 'r' must be deterministic based on that
     // choice.
     uint64_t step_seed = 12345;
-
-    for (int i = 0; i < iterations; ++i) {
+    auto next_edge = [&](std::pair<Fp2T, Fp2T> &edge) {
       // Prover chooses next step
       int idx = (step_seed >> 16) % valid_pairs.size();
       step_seed = (step_seed * 6364136223846793005ULL + 1442695040888963407ULL);
+      edge = valid_pairs[idx];
+      return true;
+    };
+    return fold_edges(coeffs_y, valid_pairs[0], next_edge, (size_t)iterations,
+                      1);
+  }
 
-      auto p_next = valid_pairs[idx];
-      Witness w_next = {p_next.first, p_next.second, Fp2T::zero()};
+  // Same protocol over an edge stream (IsogenyGraphExplorer output), folded
+  // in stream order: the first edge seeds the accumulator, the rest are the
+  // fresh witnesses. max_folds = 0 folds the whole stream; progress is
+  // logged every log_every folds.
+  static Witness run_stress_test(const std::vector<Poly> &coeffs_y,
+                                 EdgeStreamReader<Config> &edges,
+                                 size_t max_folds = 0,
+                                 size_t log_every = 4096) {
+    std::cout << "--- Starting Recursion Stress Test (edge stream, l = "
+              << edges.l << ") [Fiat-Shamir] ---" << std::endl;
 
-      // Fiat-Shamir: Absorb the new witness component
-      transcript.Absorb(w_next);
+    std::pair<Fp2T, Fp2T> first;
+    if (!edges.valid() || !edges.next(first)) {
+      std::cout << "No edges in stream!" << std::endl;
+      return Witness();
+    }
+    auto next_edge = [&](std::pair<Fp2T, Fp2T> &edge) {
+      return edges.next(edge);
+    };
+    return fold_edges(coeffs_y, first, next_edge,
+                      max_folds ? max_folds : SIZE_MAX, log_every);
+  }
 
-      // Squeeze Challenge r
-      Fp2T r = transcript.Squeeze();
+  // k-ary variant over valid_pairs: each round folds k fresh witnesses with
+  // powers of one challenge (CrossTermEngine::fold_many), one squeeze per
+  // round instead of one per witness.
+  static Witness
+  run_multi_fold_test(const std::vector<Poly> &coeffs_y,
+                      const std::vector<std::pair<Fp2T, Fp2T>> &valid_pairs,
+                      int rounds, size_t k) {
+    std::cout << "--- Starting Multi-Fold Stress Test (" << rounds
+              << " rounds, k = " << k << ") [Fiat-Shamir] ---" << std::endl;
 
-      // Ensure r is non-zero (unlikely but good practice)
-      if (r.c0.val.limbs[0] == 0 && r.c1.val.limbs[0] == 0) {
-        r.c0.val.limbs[0] = 1;
-      }
+    if (valid_pairs.empty() || k == 0) {
+      std::cout << "No valid pairs to fold!" << std::endl;
+      return Witness();
+    }
 
-      // Fold
-      Witness acc_new = Folder::fold(coeffs_y, accumulator, w_next, r);
+    uint64_t step_seed = 12345;
+    auto next_edge = [&](std::pair<Fp2T, Fp2T> &edge) {
+      int idx = (step_seed >> 16) % valid_pairs.size();
+      step_seed = (step_seed * 6364136223846793005ULL + 1442695040888963407ULL);
+      edge = valid_pairs[idx];
+      return true;
+    };
+    return fold_edges_many(coeffs_y, valid_pairs[0], next_edge, k,
+                           (size_t)rounds * k, 1);
+  }
 
-      // Verify
-      if (!Folder::verify(coeffs_y, acc_new)) {
-        std::cout << "Iter " << i << ": VERIFICATION FAILED!" << std::endl;
+  // Tree-reduction variant (TreeFolder): leaves fresh witnesses drawn from
+  // valid_pairs by a hash of the leaf index, folded on pool (nullptr runs
+  // inline). The root is the same for every pool size.
+  static Witness
+  run_tree_fold_test(const std::vector<Poly> &coeffs_y,
+                     const std::vector<std::pair<Fp2T, Fp2T>> &valid_pairs,
+                     size_t leaves, ThreadPool *pool = nullptr) {
+    std::cout << "--- Starting Tree Fold Stress Test (" << leaves
+              << " leaves, " << (pool ? pool->size() : 1)
+              << " threads) [Fiat-Shamir] ---" << std::endl;
+
+    if (valid_pairs.empty() || leaves == 0) {
+      std::cout << "No valid pairs to fold!" << std::endl;
+      return Witness();
+    }
+
+    TreeFolder<Config> tree(BivariatePoly<Fp2T>::from_rows(coeffs_y), pool);
+    auto leaf = [&](size_t i) {
+      uint64_t h = (uint64_t)i * 6364136223846793005ULL + 1442695040888963407ULL;
+      const auto &e = valid_pairs[(h >> 16) % valid_pairs.size()];
+      return Witness{e.first, e.second, Fp2T::zero()};
+    };
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto root = tree.fold(leaves, leaf);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Folded " << leaves << " leaves in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0)
+                     .count()
+              << " ms" << std::endl;
+
+    if (!tree.verify(root)) {
+      std::cout << "Root: VERIFICATION FAILED!" << std::endl;
+      return Witness();
+    }
+    std::cout << "--- Tree Fold Stress Test PASSED ---" << std::endl;
+    return root.acc;
+  }
+
+  // run_stress_test with checkpoints: the accumulator, the transcript
+  // sponge, the fold count and the walk's RNG state are saved on ckpt's
+  // schedule and once more at the end. If ckpt holds a checkpoint, the run
+  // resumes from it, so a run that is interrupted and restarted (or extended
+  // to more iterations) ends with the same accumulator as one straight run.
+  static Witness run_checkpointed_stress_test(
+      const std::vector<Poly> &coeffs_y,
+      const std::vector<std::pair<Fp2T, Fp2T>> &valid_pairs, size_t iterations,
+      Checkpointer<Config> &ckpt) {
+    std::cout << "--- Starting Checkpointed Recursion Stress Test ("
+              << iterations << " iterations, every " << ckpt.every
+              << ") [Fiat-Shamir] ---" << std::endl;
+
+    if (valid_pairs.empty()) {
+      std::cout << "No valid pairs to fold!" << std::endl;
+      return Witness();
+    }
+
+    const auto phi = BivariatePoly<Fp2T>::from_rows(coeffs_y);
+    const CrossTermEngine<Config> engine(phi);
+    PhiSpecializationCache<Config> cache(phi);
+    Transcript transcript;
+
+    // SetState leaves the transcript untouched when it fails
+    const auto relation = FoldCheckpoint<Config>::relation_tag(
+        "run_checkpointed_stress_test", coeffs_y, valid_pairs);
+    FoldCheckpoint<Config> state;
+    if (ckpt.load(state, relation) && transcript.SetState(state.sponge)) {
+      std::cout << "Resuming from " << ckpt.path << " at iteration "
+                << state.step << std::endl;
+    } else {
+      state = FoldCheckpoint<Config>();
+      state.relation = relation;
+      state.cursor = 12345; // same walk as run_stress_test
+      state.acc = {valid_pairs[0].first, valid_pairs[0].second, Fp2T::zero()};
+      transcript.Absorb(state.acc);
+    }
+
+    while (state.step < iterations) {
+      int idx = (state.cursor >> 16) % valid_pairs.size();
+      state.cursor =
+          state.cursor * 6364136223846793005ULL + 1442695040888963407ULL;
+      const auto &e = valid_pairs[idx];
+      if (!fold_step(engine, cache, transcript, state.acc,
+                     {e.first, e.second, Fp2T::zero()}, state.step))
         return Witness();
+
+      ++state.step;
+      if (ckpt.due(state.step)) {
+        state.sponge = transcript.GetState();
+        ckpt.save(state);
       }
+    }
+    state.sponge = transcript.GetState();
+    ckpt.save_synced(state);
+
+    std::cout << "Folded " << state.step << " edges, " << ckpt.writes
+              << " checkpoints (" << ckpt.syncs << " synced)" << std::endl;
+    std::cout << "--- Checkpointed Recursion Stress Test PASSED ---"
+              << std::endl;
+    return state.acc;
+  }
+
+  // Pipelined variant (FoldPipeline) over the same pseudo-random walk as
+  // run_stress_test: generation, commitment, fold and verification on four
+  // threads connected by bounded rings. Prints one line per stage.
+  static Witness run_pipelined_stress_test(
+      const std::vector<Poly> &coeffs_y,
+      const std::vector<std::pair<Fp2T, Fp2T>> &valid_pairs, size_t iterations,
+      size_t capacity = FoldPipeline<Config>::DEFAULT_CAPACITY) {
+    std::cout << "--- Starting Pipelined Recursion Stress Test (" << iterations
+              << " folds, ring capacity " << capacity << ") [Fiat-Shamir] ---"
+              << std::endl;
+
+    if (valid_pairs.empty()) {
+      std::cout << "No valid pairs to fold!" << std::endl;
+      return Witness();
+    }
+
+    uint64_t step_seed = 12345;
+    auto next_edge = [&](std::pair<Fp2T, Fp2T> &edge) {
+      int idx = (step_seed >> 16) % valid_pairs.size();
+      step_seed = (step_seed * 6364136223846793005ULL + 1442695040888963407ULL);
+      edge = valid_pairs[idx];
+      return true;
+    };
+
+    FoldPipeline<Config> pipeline(BivariatePoly<Fp2T>::from_rows(coeffs_y),
+                                  capacity);
+    auto res = pipeline.run(valid_pairs[0], next_edge, iterations);
+    for (size_t s = 0; s < FoldPipeline<Config>::STAGES; ++s) {
+      const auto &st = res.stages[s];
+      std::cout << "  " << FoldPipeline<Config>::STAGE_NAMES[s] << ": "
+                << st.items << " items, " << (uint64_t)st.busy_ms
+                << " ms busy, " << st.in_stalls << " input stalls, "
+                << st.out_stalls << " output stalls, mean input occupancy "
+                << st.in_occupancy << std::endl;
+    }
+    std::cout << "Folded " << res.folded << " edges in "
+              << (uint64_t)(res.seconds * 1000) << " ms" << std::endl;
+
+    if (!res.ok) {
+      std::cout << "Pipeline: VERIFICATION FAILED!" << std::endl;
+      return Witness();
+    }
+    std::cout << "--- Pipelined Recursion Stress Test PASSED ---" << std::endl;
+    return res.acc;
+  }
+
+  static void print_cache_stats(const PhiSpecializationCache<Config> &cache) {
+    std::cout << "Phi(j, Y) cache: " << cache.hits << " hits, " << cache.misses
+              << " misses, " << cache.evictions << " evictions ("
+              << (int)(100.0 * cache.hit_rate()) << "% hit rate)" << std::endl;
+  }
+
+  // Folds edges from next_edge(edge) into an accumulator seeded by first
+  // until max_folds or the source runs dry. log_every == 1 logs the slack of
+  // every fold.
+  template <typename NextEdge>
+  static Witness fold_edges(const std::vector<Poly> &coeffs_y,
+                            const std::pair<Fp2T, Fp2T> &first,
+                            NextEdge &&next_edge, size_t max_folds,
+                            size_t log_every) {
+    // 1. Initialize Accumulator
+    Witness accumulator = {first.first, first.second, Fp2T::zero()};
+
+    // Precompiled evaluator shared by every fold/verify below
+    const auto phi = BivariatePoly<Fp2T>::from_rows(coeffs_y);
+    const CrossTermEngine<Config> engine(phi);
+    // Fresh witnesses that repeat (valid_pairs) make their checks below
+    // cache hits after the first visit of each edge
+    PhiSpecializationCache<Config> cache(phi);
+
+    // 2. Initialize Transcript
+    Transcript transcript;
+    transcript.Absorb(accumulator); // Bind initial state
+
+    size_t i = 0;
+    std::pair<Fp2T, Fp2T> p_next;
+    for (; i < max_folds && next_edge(p_next); ++i) {
+      if (!fold_step(engine, cache, transcript, accumulator,
+                     {p_next.first, p_next.second, Fp2T::zero()}, i))
+        return Witness();
 
       // Log Slack
-      std::cout << "Iter " << i << ": Verified [FS]. Slack u = ";
-      acc_new.u.print();
-      std::cout << std::endl;
+      if (log_every == 1) {
+        std::cout << "Iter " << i << ": Verified [FS]. Slack u = ";
+        accumulator.u.print();
+        std::cout << std::endl;
+      } else if (log_every && (i + 1) % log_every == 0) {
+        std::cout << "Folded " << i + 1 << " edges [FS]" << std::endl;
+      }
+    }
+
+    if (log_every != 1)
+      std::cout << "Folded " << i << " edges in total" << std::endl;
+    print_cache_stats(cache);
+    std::cout << "--- Recursion Stress Test PASSED ---" << std::endl;
+    return accumulator;
+  }
+
+  // fold_edges with k fresh witnesses per round; max_folds counts witnesses
+  // and the last round may be shorter. log_every == 1 logs every round.
+  template <typename NextEdge>
+  static Witness fold_edges_many(const std::vector<Poly> &coeffs_y,
+                                 const std::pair<Fp2T, Fp2T> &first,
+                                 NextEdge &&next_edge, size_t k,
+                                 size_t max_folds, size_t log_every) {
+    Witness accumulator = {first.first, first.second, Fp2T::zero()};
+
+    const auto phi = BivariatePoly<Fp2T>::from_rows(coeffs_y);
+    const CrossTermEngine<Config> engine(phi);
+    PhiSpecializationCache<Config> cache(phi);
+
+    Transcript transcript;
+    transcript.Absorb(accumulator);
+
+    size_t folded = 0, round = 0;
+    std::vector<Witness> fresh;
+    std::pair<Fp2T, Fp2T> p_next;
+    for (; folded < max_folds; ++round) {
+      fresh.clear();
+      while (fresh.size() < k && folded + fresh.size() < max_folds &&
+             next_edge(p_next)) {
+        Witness w_next = {p_next.first, p_next.second, Fp2T::zero()};
+        if (!is_edge(cache, w_next, "Round", round))
+          return Witness();
+        transcript.Absorb(w_next);
+        fresh.push_back(w_next);
+      }
+      if (fresh.empty())
+        break;
+
+      // One commitment and one challenge for the whole round
+      auto T = engine.cross_terms_many(accumulator, fresh);
+      transcript.Absorb(T);
+      Fp2T r = challenge(transcript);
+
+      Witness acc_new = engine.fold_many(accumulator, fresh, T, r);
+      if (!Folder::verify(cache, acc_new)) {
+        std::cout << "Round " << round << ": VERIFICATION FAILED!"
+                  << std::endl;
+        return Witness();
+      }
+      folded += fresh.size();
+
+      if (log_every == 1) {
+        std::cout << "Round " << round << ": folded " << fresh.size()
+                  << ", verified [FS]. Slack u = ";
+        acc_new.u.print();
+        std::cout << std::endl;
+      } else if (log_every && (round + 1) % log_every == 0) {
+        std::cout << "Folded " << folded << " edges [FS]" << std::endl;
+      }
 
       accumulator = acc_new;
     }
 
-    std::cout << "--- Recursion Stress Test PASSED ---" << std::endl;
+    if (log_every != 1)
+      std::cout << "Folded " << folded << " edges in total" << std::endl;
+    print_cache_stats(cache);
+    std::cout << "--- Multi-Fold Stress Test PASSED ---" << std::endl;
     return accumulator;
   }
 
@@ -125,6 +407,11 @@ public:
     if (valid_pairs.empty())
       return;
 
+    // Phi(w1) of each fold is the Phi(w_new) of the previous one and w2 is
+    // drawn from valid_pairs: two of the three evaluations hit the cache
+    PhiSpecializationCache<Config> cache(
+        BivariatePoly<Fp2T>::from_rows(coeffs_y));
+
     // Init
     auto p0 = valid_pairs[0];
     Witness accumulator = {p0.first, p0.second, Fp2T::zero()};
@@ -145,7 +432,7 @@ public:
       Witness w_next = {p_next.first, p_next.second, Fp2T::zero()};
 
       Fp2T r = get_random_r();
-      accumulator = Folder::fold(coeffs_y, accumulator, w_next, r);
+      accumulator = Folder::fold(cache, accumulator, w_next, r);
 
       // Check specific steps requested or all? Use requested checkpoints
       // User asked: "Log ... at steps 1, 10, 100, 1000"
@@ -156,6 +443,52 @@ public:
       int hw = hamming_weight(accumulator.u);
       std::cout << i << "," << hw << std::endl;
     }
+    print_cache_stats(cache);
+  }
+
+private:
+  // Squeezes the fold challenge, bumped off zero (unlikely but good
+  // practice) so the fold never drops the fresh witness
+  static Fp2T challenge(Transcript &transcript) {
+    Fp2T r = transcript.Squeeze();
+    if (r.c0.val.limbs[0] == 0 && r.c1.val.limbs[0] == 0) {
+      r.c0.val.limbs[0] = 1;
+    }
+    return r;
+  }
+
+  static bool is_edge(PhiSpecializationCache<Config> &cache, const Witness &w,
+                      const char *label, size_t i) {
+    if (Folder::verify(cache, w))
+      return true;
+    std::cout << label << " " << i << ": witness is not an edge!" << std::endl;
+    return false;
+  }
+
+  // One Fiat-Shamir fold of the fresh witness w into acc, shared by
+  // fold_edges and run_checkpointed_stress_test: check w, absorb w and the
+  // cross terms so r is bound to them, fold with one Horner pass in r and
+  // verify the result. acc is only replaced when the new accumulator
+  // verifies; i labels the error messages.
+  static bool fold_step(const CrossTermEngine<Config> &engine,
+                        PhiSpecializationCache<Config> &cache,
+                        Transcript &transcript, Witness &acc, const Witness &w,
+                        size_t i) {
+    if (!is_edge(cache, w, "Iter", i))
+      return false;
+
+    auto T = engine.cross_terms(acc, w);
+    transcript.Absorb(w);
+    transcript.Absorb(T);
+    Fp2T r = challenge(transcript);
+
+    Witness acc_new = engine.fold(acc, w, T, r);
+    if (!Folder::verify(cache, acc_new)) {
+      std::cout << "Iter " << i << ": VERIFICATION FAILED!" << std::endl;
+      return false;
+    }
+    acc = acc_new;
+    return true;
   }
 };
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "analyzer.hpp"
+#include "bivariate.hpp"
+#include "phi_cache.hpp"
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -23,8 +26,10 @@ public:
   };
 
   // Verify: Phi2(j_start, j_end) == u
-  static bool verify(const std::vector<Poly> &coeffs_y,
-                     const RelaxedWitness &w) {
+  // coeffs_y: rows of Phi as std::vector<Poly> or SmallPoly rows
+  // (ModularPolynomial::small_rows()), see Phi2Analyzer::eval_phi.
+  template <typename Rows>
+  static bool verify(const Rows &coeffs_y, const RelaxedWitness &w) {
     Fp2T val = Phi2Analyzer<Config>::eval_phi(coeffs_y, w.j_start, w.j_end);
 
     // Check val == w.u
@@ -43,9 +48,9 @@ public:
   // Fold:
   // w_new = w1 + r * w2
   // u_new = u1 + r * u2 + E_cross
-  static RelaxedWitness fold(const std::vector<Poly> &coeffs_y,
-                             const RelaxedWitness &w1, const RelaxedWitness &w2,
-                             const Fp2T &r) {
+  template <typename Rows>
+  static RelaxedWitness fold(const Rows &coeffs_y, const RelaxedWitness &w1,
+                             const RelaxedWitness &w2, const Fp2T &r) {
     // 1. Linearly fold the j-invariants
     Fp2T r_jstart2 = Fp2T::mul(r, w2.j_start);
     Fp2T r_jend2 = Fp2T::mul(r, w2.j_end);
@@ -98,6 +103,177 @@ public:
 
     return RelaxedWitness{j_start_new, j_end_new, u_new};
   }
+
+  // Same relation, evaluated through a precompiled BivariatePoly.
+  // Build it once with BivariatePoly<Fp2T>::from_rows(coeffs_y).
+  static bool verify(const BivariatePoly<Fp2T> &phi, const RelaxedWitness &w) {
+    return Fp2T::sub(phi.eval(w.j_start, w.j_end), w.u).is_zero();
+  }
+
+  // Same fold as above; the three Phi evaluations share one batch call.
+  static RelaxedWitness fold(const BivariatePoly<Fp2T> &phi,
+                             const RelaxedWitness &w1, const RelaxedWitness &w2,
+                             const Fp2T &r) {
+    Fp2T j_start_new = Fp2T::add(w1.j_start, Fp2T::mul(r, w2.j_start));
+    Fp2T j_end_new = Fp2T::add(w1.j_end, Fp2T::mul(r, w2.j_end));
+
+    Fp2T xs[3] = {j_start_new, w1.j_start, w2.j_start};
+    Fp2T ys[3] = {j_end_new, w1.j_end, w2.j_end};
+    Fp2T vals[3];
+    phi.eval_batch(xs, ys, vals, 3);
+
+    // E = Phi(w_new) - Phi(w1) - r Phi(w2); u_new = u1 + r u2 + E
+    Fp2T error_term =
+        Fp2T::sub(vals[0], Fp2T::add(vals[1], Fp2T::mul(r, vals[2])));
+    Fp2T u_new = Fp2T::add(Fp2T::add(w1.u, Fp2T::mul(r, w2.u)), error_term);
+    return RelaxedWitness{j_start_new, j_end_new, u_new};
+  }
+
+  // k-ary fold with powers of one challenge:
+  //   w_new = acc + sum_i r^i w_i,  u_new = u_acc + sum_i r^i u_i + E,
+  //   E = Phi(w_new) - Phi(acc) - sum_i r^i Phi(w_i).
+  // fresh = {w2} is fold(phi, acc, w2, r); all k + 2 evaluations share one
+  // batch call. CrossTermEngine::cross_terms_many is the committed version.
+  static RelaxedWitness fold_many(const BivariatePoly<Fp2T> &phi,
+                                  const RelaxedWitness &acc,
+                                  const std::vector<RelaxedWitness> &fresh,
+                                  const Fp2T &r) {
+    const size_t k = fresh.size();
+    std::vector<Fp2T> xs(k + 2), ys(k + 2), vals(k + 2);
+    std::vector<Fp2T> rp(k); // r^1 .. r^k
+    RelaxedWitness w = acc;
+    Fp2T p = r;
+    for (size_t i = 0; i < k; ++i) {
+      rp[i] = p;
+      w.j_start = Fp2T::add(w.j_start, Fp2T::mul(p, fresh[i].j_start));
+      w.j_end = Fp2T::add(w.j_end, Fp2T::mul(p, fresh[i].j_end));
+      w.u = Fp2T::add(w.u, Fp2T::mul(p, fresh[i].u));
+      xs[i + 2] = fresh[i].j_start;
+      ys[i + 2] = fresh[i].j_end;
+      p = Fp2T::mul(p, r);
+    }
+    xs[0] = w.j_start;
+    ys[0] = w.j_end;
+    xs[1] = acc.j_start;
+    ys[1] = acc.j_end;
+    phi.eval_batch(xs.data(), ys.data(), vals.data(), k + 2);
+
+    Fp2T error_term = Fp2T::sub(vals[0], vals[1]);
+    for (size_t i = 0; i < k; ++i)
+      error_term = Fp2T::sub(error_term, Fp2T::mul(rp[i], vals[i + 2]));
+    w.u = Fp2T::add(w.u, error_term);
+    return w;
+  }
+
+  // Same relation through a PhiSpecializationCache: recurring j cost one
+  // Horner pass instead of a full evaluation.
+  static bool verify(PhiSpecializationCache<Config> &cache,
+                     const RelaxedWitness &w) {
+    return Fp2T::sub(cache.eval(w.j_start, w.j_end), w.u).is_zero();
+  }
+
+  static RelaxedWitness fold(PhiSpecializationCache<Config> &cache,
+                             const RelaxedWitness &w1, const RelaxedWitness &w2,
+                             const Fp2T &r) {
+    Fp2T j_start_new = Fp2T::add(w1.j_start, Fp2T::mul(r, w2.j_start));
+    Fp2T j_end_new = Fp2T::add(w1.j_end, Fp2T::mul(r, w2.j_end));
+
+    Fp2T phi_new = cache.eval(j_start_new, j_end_new);
+    Fp2T phi1 = cache.eval(w1.j_start, w1.j_end);
+    Fp2T phi2 = cache.eval(w2.j_start, w2.j_end);
+
+    Fp2T error_term = Fp2T::sub(phi_new, Fp2T::add(phi1, Fp2T::mul(r, phi2)));
+    Fp2T u_new = Fp2T::add(Fp2T::add(w1.u, Fp2T::mul(r, w2.u)), error_term);
+    return RelaxedWitness{j_start_new, j_end_new, u_new};
+  }
+
+  // Lazy fold mode: the same chain of fold(phi, acc, w_k, r_k) calls, but
+  // the error terms are settled in batches. Summed over a run, the Phi of
+  // every intermediate accumulator cancels:
+  //
+  //   u_n = u_0 + sum r_k u_k + Phi(j_n) - Phi(j_0) - sum r_k Phi(w_k),
+  //
+  // so fold() only updates j and the u_k part (three multiplications) and
+  // logs (w_k, r_k); flush() evaluates the logged Phi(w_k) and Phi(j_n) in
+  // one eval_batch call. That is 1 + 1/interval evaluations per step instead
+  // of 3, and the flushed accumulator equals the eager one exactly.
+  // Challenges must be known up front, so this suits loops whose r does not
+  // bind the intermediate accumulators (not CrossTermEngine's Fiat-Shamir).
+  // acc(), verify() and anything that checkpoints flush first; fold()
+  // flushes by itself once flush_every steps are logged (0 = never).
+  class LazyAccumulator {
+  public:
+    static constexpr size_t DEFAULT_FLUSH_EVERY = 1024;
+
+    BivariatePoly<Fp2T> phi;
+    size_t flush_every;
+    uint64_t steps = 0;   // folds since construction
+    uint64_t flushes = 0; // flushes that settled at least one step
+
+    LazyAccumulator(const BivariatePoly<Fp2T> &phi,
+                    const RelaxedWitness &start,
+                    size_t flush_every = DEFAULT_FLUSH_EVERY)
+        : phi(phi), flush_every(flush_every), cur(start),
+          phi_base(phi.eval(start.j_start, start.j_end)) {
+      if (flush_every) {
+        log_x.reserve(flush_every);
+        log_y.reserve(flush_every);
+        log_r.reserve(flush_every);
+      }
+    }
+
+    void fold(const RelaxedWitness &w, const Fp2T &r) {
+      cur.j_start = Fp2T::add(cur.j_start, Fp2T::mul(r, w.j_start));
+      cur.j_end = Fp2T::add(cur.j_end, Fp2T::mul(r, w.j_end));
+      cur.u = Fp2T::add(cur.u, Fp2T::mul(r, w.u));
+      log_x.push_back(w.j_start);
+      log_y.push_back(w.j_end);
+      log_r.push_back(r);
+      ++steps;
+      if (flush_every && log_r.size() >= flush_every)
+        flush();
+    }
+
+    void flush() {
+      const size_t m = log_r.size();
+      if (m == 0)
+        return;
+      // Phi(w_0) .. Phi(w_{m-1}), then Phi(j_n) in the same call
+      log_x.push_back(cur.j_start);
+      log_y.push_back(cur.j_end);
+      vals.resize(m + 1);
+      phi.eval_batch(log_x.data(), log_y.data(), vals.data(), m + 1);
+
+      Fp2T sum = Fp2T::zero(); // sum r_k Phi(w_k)
+      for (size_t k = 0; k < m; ++k)
+        sum = Fp2T::add(sum, Fp2T::mul(log_r[k], vals[k]));
+      cur.u = Fp2T::add(cur.u, Fp2T::sub(Fp2T::sub(vals[m], phi_base), sum));
+      phi_base = vals[m];
+
+      log_x.clear();
+      log_y.clear();
+      log_r.clear();
+      ++flushes;
+    }
+
+    size_t pending() const { return log_r.size(); }
+
+    const RelaxedWitness &acc() {
+      flush();
+      return cur;
+    }
+
+    // Phi(acc) = u; the flush already evaluated Phi(acc)
+    bool verify() {
+      flush();
+      return Fp2T::equal(phi_base, cur.u);
+    }
+
+  private:
+    RelaxedWitness cur; // j exact, u without the pending error terms
+    Fp2T phi_base;      // Phi(j) of the last settled accumulator
+    std::vector<Fp2T> log_x, log_y, log_r, vals;
+  };
 };
 
 } // namespace crypto
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "fp2.hpp"
+#include "poly.hpp"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace crypto {
+
+// Roots of univariate polynomials over Fp2 (q = p^2)
+//   1. g = gcd(f, X^q - X) keeps exactly the distinct linear factors.
+//      X^p mod f is one modular exponentiation; X^q = (X^p)^p then comes
+//      from the Frobenius table T_i = (X^p)^i mod f, since for
+//      h = sum c_i X^i we have h^p = sum conj(c_i) T_i.
+//   2. Cantor-Zassenhaus: gcd(g, (X + a)^((q-1)/2) - 1) splits g for about
+//      half of all shifts a. The exponent factors as (p-1)/2 * (p+1), so
+//      we raise to (p-1)/2 and finish with y^(p+1) = frob(y) * y.
+//      Shifts come from a short deterministic sequence, then from a seeded
+//      generator; over tiny fields the sequence repeats after p terms, so
+//      only the generator can reach every a. After SPLIT_LIMIT shifts the
+//      search gives up and find_roots reports failure.
+// Everything is polynomial in log p (O(log p) multiplications modulo a
+// polynomial of degree deg f).
+template <typename Config> class RootFinder {
+public:
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  using Poly = Polynomial<Fp2T>;
+  static constexpr size_t N = Config::N_LIMBS;
+
+  // Deterministic shifts tried before the seeded ones, and the total per
+  // split (a shift fails with probability about 1/2)
+  static constexpr uint64_t DETERMINISTIC_SHIFTS = 64;
+  static constexpr uint64_t SPLIT_LIMIT = 256;
+
+  // Distinct roots of f in Fp2 (any order); empty if splitting failed
+  static std::vector<Fp2T> find_roots(const Poly &f_in) {
+    std::vector<Fp2T> roots;
+    Poly f = Poly::monic(f_in);
+    if (f.deg() < 1)
+      return roots;
+    if (f.deg() == 1) {
+      roots.push_back(Fp2T::sub(Fp2T::zero(), f.coeffs[0]));
+      return roots;
+    }
+
+    Poly X = Poly::x(Fp2T::one(), Fp2T::zero());
+    Poly xp = Poly::powmod(X, Config::p(), f);
+    std::vector<Poly> table = frobenius_table(xp, f);
+    Poly xq = frobenius(xp, table, f);
+
+    Poly g = Poly::gcd(f, Poly::sub(xq, X));
+    if (g.deg() < 1)
+      return roots;
+
+    // (p-1)/2
+    BigInt<N> e = Config::p();
+    BigInt<N>::div_word(e, 2);
+
+    std::mt19937_64 rng(0x51a9c0de);
+    if (!split(g, e, xp, rng, roots)) {
+      std::cerr << "RootFinder: no splitting shift after " << SPLIT_LIMIT
+                << " tries" << std::endl;
+      roots.clear();
+    }
+    return roots;
+  }
+
+  // Convenience overload for coefficient vectors (low degree first)
+  static std::vector<Fp2T> find_roots(const std::vector<Fp2T> &coeffs) {
+    return find_roots(Poly(coeffs));
+  }
+
+private:
+  // T_i = (X^p)^i mod m for i < deg m
+  static std::vector<Poly> frobenius_table(const Poly &xp, const Poly &m) {
+    std::vector<Poly> table(m.deg());
+    table[0] = Poly(Fp2T::one());
+    for (int i = 1; i < m.deg(); ++i)
+      table[i] = Poly::mulmod(table[i - 1], xp, m);
+    return table;
+  }
+
+  // h^p mod m
+  static Poly frobenius(const Poly &h, const std::vector<Poly> &table,
+                        const Poly &m) {
+    std::vector<Fp2T> acc(m.deg(), Fp2T::zero());
+    for (size_t i = 0; i < h.coeffs.size(); ++i) {
+      Fp2T c = Fp2T::conj(h.coeffs[i]);
+      if (c.is_zero())
+        continue;
+      const Poly &t = table[i];
+      for (size_t k = 0; k < t.coeffs.size(); ++k)
+        acc[k] = Fp2T::add(acc[k], Fp2T::mul(c, t.coeffs[k]));
+    }
+    Poly r(acc);
+    r.normalize();
+    return r;
+  }
+
+  // Element of Fp from a word, reduced when p itself fits in one word
+  static FpT small_fp(uint64_t v) {
+    const BigInt<N> p = Config::p();
+    bool one_word = true;
+    for (size_t i = 1; i < N; ++i)
+      one_word = one_word && p.limbs[i] == 0;
+    if (one_word)
+      v %= p.limbs[0];
+    return FpT(BigInt<N>(v)).to_montgomery();
+  }
+
+  // g is monic, squarefree and a product of distinct linear factors;
+  // false if some factor did not split within SPLIT_LIMIT shifts
+  static bool split(const Poly &g, const BigInt<N> &half_pm1, const Poly &xp,
+                    std::mt19937_64 &rng, std::vector<Fp2T> &roots) {
+    if (g.deg() == 1) {
+      roots.push_back(Fp2T::sub(Fp2T::zero(), g.coeffs[0]));
+      return true;
+    }
+    Poly xp_g = Poly::mod(xp, g);
+    std::vector<Poly> table = frobenius_table(xp_g, g);
+
+    // Shifts a = k + (k^2 + 1) i, then random ones
+    for (uint64_t k = 0; k < SPLIT_LIMIT; ++k) {
+      Fp2T a = k < DETERMINISTIC_SHIFTS
+                   ? Fp2T(small_fp(k), small_fp(k * k + 1))
+                   : Fp2T(small_fp(rng()), small_fp(rng()));
+      Poly base(std::vector<Fp2T>{a, Fp2T::one()}); // X + a
+      Poly y = Poly::powmod(base, half_pm1, g);
+      y = Poly::mulmod(frobenius(y, table, g), y, g); // ^(p+1)
+      Poly h = Poly::sub(y, Poly(Fp2T::one()));
+      Poly d = Poly::gcd(g, h);
+      if (d.deg() >= 1 && d.deg() < g.deg()) {
+        Poly q, r;
+        Poly::divmod(g, d, q, r);
+        return split(d, half_pm1, xp, rng, roots) &&
+               split(Poly::monic(q), half_pm1, xp, rng, roots);
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace crypto
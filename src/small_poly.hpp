@@ -0,0 +1,149 @@
+#pragma once
+
+#include "poly.hpp"
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace crypto {
+
+// Fixed-capacity polynomial for statically bounded degrees (the neighbour
+// polynomials and rows of Phi_l are all of degree <= l + 1).
+// Coefficients live in a std::array, so nothing here touches the heap; the
+// *_into operations write their result into an existing object and may
+// alias their inputs. Converts to and from Polynomial for everything else.
+template <typename CoeffT, size_t MaxDeg> class SmallPoly {
+public:
+  static constexpr size_t CAPACITY = MaxDeg + 1;
+
+  std::array<CoeffT, CAPACITY> coeffs; // coeffs[i] is coefficient of x^i
+  size_t len = 0;                      // coefficients in use
+
+  SmallPoly() {}
+  explicit SmallPoly(const CoeffT &c) : len(1) { coeffs[0] = c; }
+
+  // p must fit: deg p <= MaxDeg once trailing zeros are dropped
+  explicit SmallPoly(const Polynomial<CoeffT> &p) {
+    size_t n = p.coeffs.size();
+    while (n > 0 && p.coeffs[n - 1].is_zero())
+      --n;
+    assert(n <= CAPACITY);
+    len = n;
+    for (size_t i = 0; i < n; ++i)
+      coeffs[i] = p.coeffs[i];
+  }
+
+  Polynomial<CoeffT> to_poly() const {
+    return Polynomial<CoeffT>(
+        std::vector<CoeffT>(coeffs.begin(), coeffs.begin() + len));
+  }
+
+  // Degree after trim(), -1 for zero
+  int deg() const { return (int)len - 1; }
+
+  bool is_zero() const {
+    for (size_t i = 0; i < len; ++i)
+      if (!coeffs[i].is_zero())
+        return false;
+    return true;
+  }
+
+  void trim() {
+    while (len > 0 && coeffs[len - 1].is_zero())
+      --len;
+  }
+
+  const CoeffT &operator[](size_t i) const { return coeffs[i]; }
+
+  // Horner
+  CoeffT eval(const CoeffT &x) const {
+    if (len == 0)
+      return CoeffT::zero();
+    CoeffT res = coeffs[len - 1];
+    for (size_t i = len - 1; i-- > 0;)
+      res = CoeffT::add(CoeffT::mul(res, x), coeffs[i]);
+    return res;
+  }
+
+  static void add_into(SmallPoly &out, const SmallPoly &a, const SmallPoly &b) {
+    size_t n = std::max(a.len, b.len);
+    for (size_t i = 0; i < n; ++i) {
+      if (i >= a.len)
+        out.coeffs[i] = b.coeffs[i];
+      else if (i >= b.len)
+        out.coeffs[i] = a.coeffs[i];
+      else
+        out.coeffs[i] = CoeffT::add(a.coeffs[i], b.coeffs[i]);
+    }
+    out.len = n;
+    out.trim();
+  }
+
+  static void sub_into(SmallPoly &out, const SmallPoly &a, const SmallPoly &b) {
+    size_t n = std::max(a.len, b.len);
+    for (size_t i = 0; i < n; ++i) {
+      if (i >= a.len)
+        out.coeffs[i] = CoeffT::sub(CoeffT::zero(), b.coeffs[i]);
+      else if (i >= b.len)
+        out.coeffs[i] = a.coeffs[i];
+      else
+        out.coeffs[i] = CoeffT::sub(a.coeffs[i], b.coeffs[i]);
+    }
+    out.len = n;
+    out.trim();
+  }
+
+  static void scale_into(SmallPoly &out, const SmallPoly &a, const CoeffT &s) {
+    for (size_t i = 0; i < a.len; ++i)
+      out.coeffs[i] = CoeffT::mul(a.coeffs[i], s);
+    out.len = a.len;
+    out.trim();
+  }
+
+  // deg a + deg b must not exceed MaxDeg
+  static void mul_into(SmallPoly &out, const SmallPoly &a, const SmallPoly &b) {
+    if (a.len == 0 || b.len == 0) {
+      out.len = 0;
+      return;
+    }
+    size_t n = a.len + b.len - 1;
+    assert(n <= CAPACITY);
+    std::array<CoeffT, CAPACITY> res; // out may alias a or b
+    for (size_t k = 0; k < n; ++k)
+      res[k] = CoeffT::zero();
+    for (size_t i = 0; i < a.len; ++i)
+      for (size_t j = 0; j < b.len; ++j)
+        res[i + j] =
+            CoeffT::add(res[i + j], CoeffT::mul(a.coeffs[i], b.coeffs[j]));
+    for (size_t k = 0; k < n; ++k)
+      out.coeffs[k] = res[k];
+    out.len = n;
+  }
+
+  // out = a * (X - root), in place from the top down
+  static void mul_linear_into(SmallPoly &out, const SmallPoly &a,
+                              const CoeffT &root) {
+    if (a.len == 0) {
+      out.len = 0;
+      return;
+    }
+    assert(a.len < CAPACITY);
+    size_t n = a.len;
+    out.coeffs[n] = a.coeffs[n - 1];
+    for (size_t i = n - 1; i > 0; --i)
+      out.coeffs[i] =
+          CoeffT::sub(a.coeffs[i - 1], CoeffT::mul(root, a.coeffs[i]));
+    out.coeffs[0] = CoeffT::sub(CoeffT::zero(), CoeffT::mul(root, a.coeffs[0]));
+    out.len = n + 1;
+  }
+
+  // out = prod (X - roots[i]), n <= MaxDeg
+  static void from_roots_into(SmallPoly &out, const CoeffT *roots, size_t n) {
+    out.coeffs[0] = CoeffT::mont_one();
+    out.len = 1;
+    for (size_t i = 0; i < n; ++i)
+      mul_linear_into(out, out, roots[i]);
+  }
+};
+
+} // namespace crypto
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+// Bounded lock-free single-producer / single-consumer ring
+// One thread calls push / close, one other thread calls pop. head and tail
+// only ever grow (slot = index & mask) and live on separate cache lines;
+// each side keeps a cached copy of the other's index and re-reads the atomic
+// only when the ring looks full (producer) or empty (consumer).
+//
+// push() blocks while the ring is full (backpressure), pop() while it is
+// empty; both spin briefly, then yield. pop() returns false once the
+// producer has closed the ring and it is drained.
+//
+// Metrics, readable once both threads are done: full_stalls() counts pushes
+// that had to wait, empty_stalls() pops that had to wait, and
+// mean_occupancy() is the average fill level seen by successful pops.
+template <typename T> class SpscRing {
+public:
+  // capacity is rounded up to a power of two
+  explicit SpscRing(size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity)
+      cap <<= 1;
+    slots.resize(cap);
+    mask = cap - 1;
+  }
+
+  SpscRing(const SpscRing &) = delete;
+  SpscRing &operator=(const SpscRing &) = delete;
+
+  size_t capacity() const { return mask + 1; }
+
+  // Producer side
+  bool try_push(T &&v) {
+    const uint64_t t = prod.tail.load(std::memory_order_relaxed);
+    if (t - prod.head_cache >= capacity()) {
+      prod.head_cache = cons.head.load(std::memory_order_acquire);
+      if (t - prod.head_cache >= capacity())
+        return false;
+    }
+    slots[t & mask] = std::move(v);
+    prod.tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  void push(T v) {
+    if (try_push(std::move(v)))
+      return;
+    ++prod.stalls;
+    for (unsigned spins = 0; !try_push(std::move(v)); ++spins)
+      backoff(spins);
+  }
+
+  void close() { closed.store(true, std::memory_order_release); }
+
+  // Consumer side
+  bool try_pop(T &out) {
+    const uint64_t h = cons.head.load(std::memory_order_relaxed);
+    if (h == cons.tail_cache) {
+      cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+      if (h == cons.tail_cache)
+        return false;
+    }
+    cons.occupancy_sum += cons.tail_cache - h;
+    out = std::move(slots[h & mask]);
+    cons.head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &out) {
+    if (try_pop(out))
+      return true;
+    ++cons.stalls;
+    for (unsigned spins = 0;; ++spins) {
+      // closed is read before the last look, so nothing pushed before
+      // close() can be missed
+      bool done = closed.load(std::memory_order_acquire);
+      if (try_pop(out))
+        return true;
+      if (done)
+        return false;
+      backoff(spins);
+    }
+  }
+
+  uint64_t full_stalls() const { return prod.stalls; }
+  uint64_t empty_stalls() const { return cons.stalls; }
+  uint64_t popped() const { return cons.head.load(); }
+  double mean_occupancy() const {
+    uint64_t n = popped();
+    return n ? (double)cons.occupancy_sum / (double)n : 0.0;
+  }
+
+private:
+  // Each side's index, cached copy and counters share one cache line
+  struct alignas(64) Producer {
+    std::atomic<uint64_t> tail{0}; // next slot to push
+    uint64_t head_cache = 0;
+    uint64_t stalls = 0;
+  };
+  struct alignas(64) Consumer {
+    std::atomic<uint64_t> head{0}; // next slot to pop
+    uint64_t tail_cache = 0;
+    uint64_t stalls = 0;
+    uint64_t occupancy_sum = 0;
+  };
+
+  Producer prod;
+  Consumer cons;
+  std::atomic<bool> closed{false};
+  std::vector<T> slots;
+  size_t mask = 0;
+
+  static void backoff(unsigned spins) {
+    if (spins >= 64)
+      std::this_thread::yield();
+  }
+};
+
+} // namespace crypto
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "curve.hpp"
+#include "fp2.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+
+// Supersingularity test for Montgomery curves y^2 = x^3 + A x^2 + x over Fp2
+// classify() runs Sutherland's walk ("Identifying supersingular elliptic
+// curves", 2012) in the 2-isogeny graph. For ordinary j the graph is a
+// volcano of depth d <= log2 p + 1, and a floor vertex has only one rational
+// 2-isogeny. Three non-backtracking walks start along the three edges of j;
+// an ordinary j sends at least one of them down, and it gets stuck within d
+// steps. Supersingular walks never get stuck. Deterministic, one Fp2 square
+// root per walk and step, no Phi_2 needed.
+//
+// Ordinary curves usually get stuck within a few steps, before the two
+// full-width ladders of order_check() would finish: at p434 the walk rejects
+// one in about 4.7 ms, the ladders take about 10 ms (benchmark_isogeny,
+// [SUPERSINGULAR]). A supersingular curve costs a full walk (about 0.9 s)
+// either way and the ladders would only add to it, so classify() does not
+// run them. order_check() stays available as an independent necessary
+// condition: a supersingular Montgomery curve over Fp2 has trace +-2p
+// (traces 0 and +-p give an odd or 2 mod 4 group order, but (0,0) is always
+// rational), so Frobenius acts as +-p, E(Fp2) and its twist are E[p - 1] and
+// E[p + 1], and every x satisfies [p + 1]P = O or [p - 1]P = O.
+//
+// Walk steps use the Montgomery model directly: for the 2-isogeny with kernel
+// (x:1), x^2 + A x + 1 = 0, the codomain is A' = 2 - 4x^2 (Compute2IsoCurve)
+// and the dual has kernel (0,0) on A'. So the backtrack edge is always (0,0),
+// a vertex is stuck iff A^2 - 4 is not a square (the other two kernels are
+// not rational), and with s = sqrt(A^2 - 4) the next vertex is
+//
+//   A' = 2 (3 - A^2 + A s).
+//
+// The usual first test of the algorithm (j in Fp2) holds for every A in Fp2.
+template <typename Config> class SupersingularityTest {
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  using Curve = MontgomeryCurve<Config>;
+  using Point = PointProj<Config>;
+
+public:
+  // Why a candidate was accepted or rejected
+  enum class Verdict : uint8_t {
+    Singular,     // A = +-2
+    Walk,         // rejected by the 2-isogeny walk
+    Supersingular // passed the walk
+  };
+
+  struct BatchStats {
+    size_t candidates = 0;
+    size_t singular = 0;
+    size_t walk_rejected = 0;
+    size_t supersingular = 0;
+  };
+
+  // Steps per walk, ceil(log2 p) + 1 or more
+  static size_t walk_length() { return Config::p().bit_length() + 1; }
+
+  static bool is_supersingular(const Fp2T &A) {
+    return classify(A) == Verdict::Supersingular;
+  }
+
+  static Verdict classify(const Fp2T &A) {
+    if (Fp2T::sub(Fp2T::sqr(A), four()).is_zero())
+      return Verdict::Singular;
+    if (!walk(A))
+      return Verdict::Walk;
+    return Verdict::Supersingular;
+  }
+
+  // Order check alone: necessary, not sufficient
+  static bool order_check(const Fp2T &A) {
+    BigInt<Config::N_LIMBS> p_plus = Config::p(), p_minus = Config::p();
+    BigInt<Config::N_LIMBS>::add(p_plus, p_plus, BigInt<Config::N_LIMBS>(1));
+    BigInt<Config::N_LIMBS>::sub(p_minus, p_minus,
+                                 BigInt<Config::N_LIMBS>(1));
+
+    // x = 3 lies on the curve or its twist; (0:1) would break xADD
+    Point P{small(3), Fp2T::one()};
+    Fp2T C = Fp2T::one();
+    if (Curve::xMUL(P, p_plus, A, C).Z.is_zero())
+      return true;
+    return Curve::xMUL(P, p_minus, A, C).Z.is_zero();
+  }
+
+  // Sutherland's walk, exact for nonsingular A
+  static bool walk(const Fp2T &A) {
+    Fp2T s;
+    if (!split(A, s))
+      return false; // not all three 2-isogenies rational
+
+    // Walks 0 and 1 leave through the kernels (x:1), so their parent sits
+    // behind (0,0) from the start.
+    Fp2T W[3];
+    W[0] = next(A, s);
+    W[1] = next(A, Fp2T::sub(Fp2T::zero(), s));
+
+    // Walk 2 leaves through (0,0) (Compute2IsoCurveZero, A' = -2A / s). The
+    // dual kernel of that isogeny is not known in closed form, so its first
+    // step compares j: it takes the (x:1) child unless that one leads back.
+    Fp2T B = Fp2T::mul(Fp2T::sub(Fp2T::zero(), Fp2T::add(A, A)), Fp2T::inv(s));
+    Fp2T t;
+    if (!split(B, t))
+      return false;
+    W[2] = next(B, t);
+    if (Fp2T::equal(Curve::j_invariant(W[2]), Curve::j_invariant(A)))
+      W[2] = next(B, Fp2T::sub(Fp2T::zero(), t));
+
+    // Lockstep, so an ordinary curve stops at the shallowest floor
+    const size_t m = walk_length();
+    for (size_t step = 1; step < m; ++step)
+      for (Fp2T &a : W) {
+        if (!split(a, t))
+          return false;
+        a = next(a, t);
+      }
+    return true;
+  }
+
+  // Verdicts for many candidates, one index per task; ordering and results
+  // do not depend on the pool size. pool == nullptr runs inline.
+  static std::vector<Verdict> classify_batch(const std::vector<Fp2T> &As,
+                                             ThreadPool *pool = nullptr) {
+    std::vector<Verdict> out(As.size());
+    auto task = [&](size_t i) { out[i] = classify(As[i]); };
+    if (pool) {
+      pool->parallel_for(As.size(), task);
+    } else {
+      for (size_t i = 0; i < As.size(); ++i)
+        task(i);
+    }
+    return out;
+  }
+
+  // The supersingular candidates, in input order
+  static std::vector<Fp2T> filter(const std::vector<Fp2T> &As,
+                                  ThreadPool *pool = nullptr,
+                                  BatchStats *stats = nullptr) {
+    std::vector<Verdict> v = classify_batch(As, pool);
+    std::vector<Fp2T> out;
+    BatchStats st;
+    st.candidates = As.size();
+    for (size_t i = 0; i < As.size(); ++i) {
+      switch (v[i]) {
+      case Verdict::Singular:
+        ++st.singular;
+        break;
+      case Verdict::Walk:
+        ++st.walk_rejected;
+        break;
+      case Verdict::Supersingular:
+        ++st.supersingular;
+        out.push_back(As[i]);
+        break;
+      }
+    }
+    if (stats)
+      *stats = st;
+    return out;
+  }
+
+private:
+  static Fp2T small(uint64_t v) {
+    Fp2T r;
+    r.c0 = FpT(BigInt<Config::N_LIMBS>(v)).to_montgomery();
+    return r;
+  }
+
+  static Fp2T four() { return small(4); }
+
+  // s = sqrt(A^2 - 4); false if A^2 - 4 is not a square (or zero, which no
+  // isogenous curve of a nonsingular one can reach)
+  static bool split(const Fp2T &A, Fp2T &s) {
+    Fp2T disc = Fp2T::sub(Fp2T::sqr(A), four());
+    if (disc.is_zero())
+      return false;
+    s = Fp2T::sqrt(disc);
+    return Fp2T::equal(Fp2T::sqr(s), disc);
+  }
+
+  // Codomain of the kernel (x:1), x = (-A + s) / 2: 2 - 4x^2 = 2(3 - A^2 + As)
+  static Fp2T next(const Fp2T &A, const Fp2T &s) {
+    Fp2T t = Fp2T::add(Fp2T::sub(small(3), Fp2T::sqr(A)), Fp2T::mul(A, s));
+    return Fp2T::add(t, t);
+  }
+};
+
+} // namespace crypto
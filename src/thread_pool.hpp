@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crypto {
+
+// Fixed-size worker pool
+// parallel_for(n, fn) runs fn(0) .. fn(n-1) and returns when all are done.
+// Indices are claimed from a shared counter by the workers *and* by the
+// calling thread, so a parallel_for issued from inside another one (e.g.
+// several Phi_l generated at once, each fanning out its data points) always
+// makes progress even when every worker is busy. fn must not depend on which
+// thread runs an index; results written by index are then identical for any
+// pool size.
+class ThreadPool {
+public:
+  // threads counts the calling thread: ThreadPool(1) spawns no workers and
+  // runs everything inline. 0 picks std::thread::hardware_concurrency().
+  explicit ThreadPool(size_t threads = 0) {
+    if (threads == 0)
+      threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t i = 1; i < threads; ++i)
+      workers.emplace_back([this]() { worker_loop(); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cv.notify_all();
+    for (auto &t : workers)
+      t.join();
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t size() const { return workers.size() + 1; }
+
+  template <typename Func> void parallel_for(size_t n, Func &&fn) {
+    if (n == 0)
+      return;
+    if (workers.empty() || n == 1) {
+      for (size_t i = 0; i < n; ++i)
+        fn(i);
+      return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->n = n;
+    job->fn = [&fn](size_t i) { fn(i); };
+
+    size_t helpers = std::min(workers.size(), n - 1);
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      for (size_t h = 0; h < helpers; ++h)
+        queue.push_back(job);
+    }
+    cv.notify_all();
+
+    job->run();
+    std::unique_lock<std::mutex> lock(job->mtx);
+    job->cv.wait(lock, [&]() { return job->done.load() == job->n; });
+  }
+
+private:
+  struct Job {
+    size_t n = 0;
+    std::function<void(size_t)> fn;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    // Claim indices until none are left. A helper that arrives after the
+    // last index was claimed returns without touching fn.
+    void run() {
+      for (;;) {
+        size_t i = next.fetch_add(1);
+        if (i >= n)
+          return;
+        fn(i);
+        if (done.fetch_add(1) + 1 == n) {
+          std::lock_guard<std::mutex> lock(mtx);
+          cv.notify_all();
+        }
+      }
+    }
+  };
+
+  void worker_loop() {
+    for (;;) {
+      std::shared_ptr<Job> job;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if (stopping && queue.empty())
+          return;
+        job = std::move(queue.front());
+        queue.pop_front();
+      }
+      job->run();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::deque<std::shared_ptr<Job>> queue;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool stopping = false;
+};
+
+} // namespace crypto
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "cache_io.hpp"
+#include "curve.hpp"
+#include "fp2.hpp"
+#include <iostream>
+#include <vector>
+
+namespace crypto {
+
+// Deterministic torsion bases
+// For a supersingular Montgomery curve (A : 1) with E(Fp2) = (Z/(p+1))^2 and
+// p + 1 = ell^e * cofactor, produces x(P), x(Q), x(P - Q) for a basis
+// <P, Q> = E[ell^e] (ell = 2 or 3):
+//   1. Candidates come from Elligator 2 with r = 1, 2, 3, ... so they are
+//      always on E (never on the twist) and the result is reproducible.
+//   2. Two candidates at a time are pushed through one lockstep Montgomery
+//      ladder by the cofactor.
+//   3. Order check: [ell^(e-1)]P != O. Independence: the order-ell points
+//      below P and Q generate different subgroups.
+//   4. x(P - Q) is a root of the quadratic whose roots are x(P +- Q).
+// Bases are cached on disk (CacheIO) keyed by (p, A, ell); the starting
+// curve's bases are also kept in memory for the lifetime of the process.
+template <typename Config> class TorsionBasisGenerator {
+public:
+  using Fp2T = Fp2<Config>;
+  using FpT = Fp<Config>;
+  using Point = PointProj<Config>;
+  using Curve = MontgomeryCurve<Config>;
+  static constexpr size_t N = Config::N_LIMBS;
+  static constexpr uint32_t CACHE_VERSION = 1;
+
+  struct Basis {
+    int ell = 0;
+    size_t e = 0;        // basis of E[ell^e]
+    Fp2T xP, xQ, xPQ;    // affine x-coordinates; xPQ = x(P - Q)
+
+    Point P() const { return Point{xP, Fp2T::one()}; }
+    Point Q() const { return Point{xQ, Fp2T::one()}; }
+    Point PmQ() const { return Point{xPQ, Fp2T::one()}; }
+  };
+
+  static Fp2T constant(uint64_t k) {
+    return Fp2T(FpT(BigInt<N>(k)).to_montgomery(), FpT::zero());
+  }
+
+  // p + 1 = ell^e * cofactor with ell coprime to cofactor
+  static size_t torsion_exponent(int ell, BigInt<N> &cofactor) {
+    BigInt<N>::add(cofactor, Config::p(), BigInt<N>(1));
+    size_t e = 0;
+    for (;;) {
+      BigInt<N> tmp = cofactor;
+      if (BigInt<N>::div_word(tmp, ell) != 0)
+        break;
+      cofactor = tmp;
+      e++;
+    }
+    return e;
+  }
+
+  // [k]P1 and [k]P2 with a single scan of k; the two ladders are independent
+  // so their field operations interleave.
+  static void xMUL2(Point &R1, Point &R2, const Point &P1, const Point &P2,
+                    const BigInt<N> &k, const Fp2T &A, const Fp2T &C) {
+    int i = (int)k.bit_length() - 1;
+    if (i < 0) {
+      R1 = R2 = Point::infinity();
+      return;
+    }
+    Point a0 = P1, b0 = P2, a1, b1;
+    Curve::xDBL(a1, P1, A, C);
+    Curve::xDBL(b1, P2, A, C);
+    for (i = i - 1; i >= 0; --i) {
+      if (k.get_bit(i)) {
+        Curve::xADD(a0, a0, a1, P1);
+        Curve::xADD(b0, b0, b1, P2);
+        Curve::xDBL(a1, a1, A, C);
+        Curve::xDBL(b1, b1, A, C);
+      } else {
+        Curve::xADD(a1, a0, a1, P1);
+        Curve::xADD(b1, b0, b1, P2);
+        Curve::xDBL(a0, a0, A, C);
+        Curve::xDBL(b0, b0, A, C);
+      }
+    }
+    R1 = a0;
+    R2 = b0;
+  }
+
+  // [ell]P for ell = 2, 3
+  static Point xMULell(const Point &P, int ell, const Fp2T &A, const Fp2T &C) {
+    Point R;
+    Curve::xDBL(R, P, A, C);
+    if (ell == 3)
+      Curve::xADD(R, R, P, P);
+    return R;
+  }
+
+  // Elligator 2 on y^2 = x^3 + Ax^2 + x with non-square u:
+  // x1 = -A / (1 + u r^2); if f(x1) is not a square then f(-x1 - A) is.
+  static bool elligator(const Fp2T &A, const Fp2T &u, uint64_t r, Fp2T &x) {
+    Fp2T rr = constant(r);
+    Fp2T den = Fp2T::add(Fp2T::one(), Fp2T::mul(u, Fp2T::sqr(rr)));
+    Fp2T x1 = Fp2T::sub(Fp2T::zero(), Fp2T::mul(A, Fp2T::inv(den)));
+    if (x1.is_zero())
+      return false; // A = 0: every candidate maps to the 2-torsion point
+    Fp2T f = Fp2T::add(Fp2T::mul(Fp2T::add(x1, A), Fp2T::sqr(x1)), x1);
+    x = Fp2T::is_square(f) ? x1 : Fp2T::sub(Fp2T::sub(Fp2T::zero(), x1), A);
+    return true;
+  }
+
+  static Fp2T non_square() {
+    for (uint64_t k = 1;; ++k) {
+      Fp2T u(FpT(BigInt<N>(k)).to_montgomery(), FpT::mont_one());
+      if (!Fp2T::is_square(u))
+        return u;
+    }
+  }
+
+  static bool generate(const Fp2T &A, int ell, Basis &out) {
+    if (ell != 2 && ell != 3) {
+      std::cerr << "TorsionBasisGenerator: only ell = 2, 3 supported"
+                << std::endl;
+      return false;
+    }
+    BigInt<N> cof;
+    size_t e = torsion_exponent(ell, cof);
+    if (e == 0)
+      return false;
+
+    const Fp2T C = Fp2T::one();
+    const Fp2T u = non_square();
+
+    // Order-ell^e candidates, in Elligator order. T is [ell^(e-1)] of the
+    // candidate, used for the independence test.
+    std::vector<Point> full, low;
+    uint64_t r = 1;
+    for (int round = 0; round < 64 && full.size() < 2; ++round) {
+      Point cand[2];
+      size_t n = 0;
+      while (n < 2) {
+        Fp2T x;
+        if (!elligator(A, u, r++, x))
+          return false;
+        cand[n++] = Point{x, Fp2T::one()};
+      }
+      Point R[2];
+      xMUL2(R[0], R[1], cand[0], cand[1], cof, A, C);
+
+      for (int k = 0; k < 2 && full.size() < 2; ++k) {
+        if (R[k].Z.is_zero())
+          continue;
+        Point T = R[k];
+        for (size_t i = 0; i + 1 < e; ++i)
+          T = xMULell(T, ell, A, C);
+        if (T.Z.is_zero())
+          continue; // order below ell^e
+        if (!xMULell(T, ell, A, C).Z.is_zero()) {
+          std::cerr << "TorsionBasisGenerator: curve order is not (p+1)^2"
+                    << std::endl;
+          return false;
+        }
+        if (!low.empty() &&
+            Fp2T::equal(Fp2T::mul(T.X, low[0].Z), Fp2T::mul(low[0].X, T.Z)))
+          continue; // same order-ell subgroup as P
+        full.push_back(R[k]);
+        low.push_back(T);
+      }
+    }
+    if (full.size() < 2)
+      return false;
+
+    // Affine x(P), x(Q) with one inversion
+    Fp2T zs[2] = {full[0].Z, full[1].Z};
+    Fp2T::batch_inv(zs, 2);
+    Fp2T xP = Fp2T::mul(full[0].X, zs[0]);
+    Fp2T xQ = Fp2T::mul(full[1].X, zs[1]);
+
+    // x(P+Q), x(P-Q) = (a +- sqrt(a^2 - b d)) / d with
+    // a = (xP xQ + 1)(xP + xQ) + 2A xP xQ, b = (xP xQ - 1)^2, d = (xP - xQ)^2
+    Fp2T xx = Fp2T::mul(xP, xQ);
+    Fp2T a = Fp2T::add(Fp2T::mul(Fp2T::add(xx, Fp2T::one()), Fp2T::add(xP, xQ)),
+                       Fp2T::mul(Fp2T::add(A, A), xx));
+    Fp2T b = Fp2T::sqr(Fp2T::sub(xx, Fp2T::one()));
+    Fp2T d = Fp2T::sqr(Fp2T::sub(xP, xQ));
+    Fp2T disc = Fp2T::sub(Fp2T::sqr(a), Fp2T::mul(b, d));
+    Fp2T s = Fp2T::sqrt(disc);
+    if (!Fp2T::equal(Fp2T::sqr(s), disc))
+      return false;
+
+    out.ell = ell;
+    out.e = e;
+    out.xP = xP;
+    out.xQ = xQ;
+    out.xPQ = Fp2T::mul(Fp2T::add(a, s), Fp2T::inv(d));
+    return true;
+  }
+
+  // Disk-cached generate(); recomputes and rewrites the file on any mismatch
+  static bool load_or_generate(const Fp2T &A, int ell, Basis &out) {
+    std::vector<uint8_t> key = cache_key(A, ell);
+    uint8_t digest[32];
+    sha3_256(key.data(), key.size(), digest);
+    std::string path =
+        CacheIO::path_for("torsion_" + std::to_string(ell) + "_" +
+                          CacheIO::hex(digest, 8) + ".bin");
+
+    std::vector<uint8_t> payload;
+    if (CacheIO::read_validated(path, CacheIO::KIND_TORSION_BASIS,
+                                CACHE_VERSION, payload) &&
+        deserialize(payload, key, out))
+      return true;
+
+    if (!generate(A, ell, out))
+      return false;
+    if (!CacheIO::write_atomic(path, CacheIO::KIND_TORSION_BASIS,
+                               CACHE_VERSION, serialize(key, out)))
+      std::cerr << "TorsionBasisGenerator: could not write " << path
+                << std::endl;
+    return true;
+  }
+
+  // Bases of the starting curve E0 : y^2 = x^3 + 6x^2 + x, loaded once per
+  // process.
+  static const Basis &starting_curve(int ell) {
+    static const Basis b2 = load_starting(2);
+    static const Basis b3 = load_starting(3);
+    return ell == 3 ? b3 : b2;
+  }
+
+private:
+  static Basis load_starting(int ell) {
+    Basis b;
+    if (!load_or_generate(constant(6), ell, b))
+      std::cerr << "TorsionBasisGenerator: no " << ell
+                << "-power basis for E0" << std::endl;
+    return b;
+  }
+
+  // (p, A, ell): stored in the payload too, so a file name collision can
+  // never hand back the wrong basis
+  static std::vector<uint8_t> cache_key(const Fp2T &A, int ell) {
+    std::vector<uint8_t> key;
+    CacheIO::put(key, Config::p().limbs);
+    CacheIO::put_fp2(key, A);
+    CacheIO::put(key, (int32_t)ell);
+    return key;
+  }
+
+  static std::vector<uint8_t> serialize(const std::vector<uint8_t> &key,
+                                        const Basis &b) {
+    std::vector<uint8_t> buf = key;
+    CacheIO::put(buf, (uint64_t)b.e);
+    CacheIO::put_fp2(buf, b.xP);
+    CacheIO::put_fp2(buf, b.xQ);
+    CacheIO::put_fp2(buf, b.xPQ);
+    return buf;
+  }
+
+  static bool deserialize(const std::vector<uint8_t> &buf,
+                          const std::vector<uint8_t> &key, Basis &b) {
+    if (buf.size() < key.size() ||
+        memcmp(buf.data(), key.data(), key.size()) != 0)
+      return false;
+    size_t off = key.size();
+    int32_t ell;
+    memcpy(&ell, key.data() + key.size() - sizeof(ell), sizeof(ell));
+    uint64_t e;
+    if (!CacheIO::get(buf, off, e) || !CacheIO::get_fp2(buf, off, b.xP) ||
+        !CacheIO::get_fp2(buf, off, b.xQ) ||
+        !CacheIO::get_fp2(buf, off, b.xPQ))
+      return false;
+    b.ell = ell;
+    b.e = (size_t)e;
+    return off == buf.size();
+  }
+};
+
+} // namespace crypto
@@ -1,85 +1,17 @@
 #pragma once
 
+#include "cross_terms.hpp"
 #include "fp2.hpp"
+#include "keccak.hpp"
 #include "relaxed_folding.hpp"
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <vector>
 
 namespace crypto {
 
-// Minimal Keccak-f[1600] implementation for SHA3-256
-// Based on standard reference logic
-class Keccak {
-  static const int NR = 24;
-  static const uint64_t RC[24];
-  static const int RHO_OFFSETS[5][5];
-
-  static uint64_t rotl64(uint64_t x, int i) {
-    return (x << i) | (x >> (64 - i));
-  }
-
-public:
-  static void keccak_f1600(uint64_t *A) {
-    for (int round = 0; round < NR; ++round) {
-      // Theta
-      uint64_t C[5], D[5];
-      for (int x = 0; x < 5; ++x) {
-        C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
-      }
-      for (int x = 0; x < 5; ++x) {
-        D[x] = C[(x + 4) % 5] ^ rotl64(C[(x + 1) % 5], 1);
-      }
-      for (int x = 0; x < 5; ++x) {
-        for (int y = 0; y < 5; ++y) {
-          A[x + 5 * y] ^= D[x];
-        }
-      }
-
-      // Rho and Pi
-      uint64_t B[25];
-      for (int x = 0; x < 5; ++x) {
-        for (int y = 0; y < 5; ++y) {
-          B[y + 5 * ((2 * x + 3 * y) % 5)] =
-              rotl64(A[x + 5 * y], RHO_OFFSETS[x][y]);
-        }
-      }
-
-      // Chi
-      for (int x = 0; x < 5; ++x) {
-        for (int y = 0; y < 5; ++y) {
-          A[x + 5 * y] = B[x + 5 * y] ^
-                         ((~B[(x + 1) % 5 + 5 * y]) & B[(x + 2) % 5 + 5 * y]);
-        }
-      }
-
-      // Iota
-      A[0] ^= RC[round];
-    }
-  }
-};
-
-// Initialized constants (Need to be defined in a .cpp or inline if C++17)
-// For header-only, we can use inline variables or just static const inside
-// function/class if tricky. Let's rely on C++17 inline variables if possible,
-// or just define them here with 'inline' which is C++17 standard.
-inline const uint64_t Keccak::RC[24] = {
-    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
-    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
-    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
-    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
-    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
-    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
-    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
-    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
-
-inline const int Keccak::RHO_OFFSETS[5][5] = {{0, 1, 62, 28, 27},
-                                              {36, 44, 6, 55, 20},
-                                              {3, 10, 43, 25, 39},
-                                              {41, 45, 15, 21, 8},
-                                              {18, 2, 61, 56, 14}};
-
 template <typename Config> class Transcript {
   using Fp2T = Fp2<Config>;
   using Witness = typename RelaxedIsogenyFolder<Config>::RelaxedWitness;
@@ -129,6 +61,53 @@ public:
     Absorb(w.u);
   }
 
+  // Cross-term commitment of a fold; absorb it before squeezing r
+  template <size_t MaxDeg> void Absorb(const CrossTerms<Config, MaxDeg> &T) {
+    for (size_t d = 1; d <= T.degree; ++d)
+      Absorb(T.t[d]);
+  }
+
+  // Same for a k-ary fold
+  void Absorb(const MultiCrossTerms<Config> &T) {
+    for (size_t d = 1; d < T.t.size(); ++d)
+      Absorb(T.t[d]);
+  }
+
+  // 32 bytes of state after a permutation, a fingerprint of everything
+  // absorbed so far. Seeds other transcripts (TreeFolder parents).
+  using Digest = std::array<uint8_t, 32>;
+
+  Digest SqueezeDigest() {
+    Permute();
+    Digest d;
+    memcpy(d.data(), state, d.size());
+    return d;
+  }
+
+  void Absorb(const Digest &d) { AbsorbBytes(d.data(), d.size()); }
+
+  // Raw sponge (lanes and absorb position), for checkpoints: a transcript
+  // restored with SetState continues exactly where GetState left it
+  struct SpongeState {
+    std::array<uint64_t, 25> lanes;
+    uint32_t pt;
+  };
+
+  SpongeState GetState() const {
+    SpongeState s;
+    memcpy(s.lanes.data(), state, sizeof(state));
+    s.pt = (uint32_t)pt;
+    return s;
+  }
+
+  bool SetState(const SpongeState &s) {
+    if (s.pt >= (uint32_t)RATE_BYTES)
+      return false;
+    memcpy(state, s.lanes.data(), sizeof(state));
+    pt = (int)s.pt;
+    return true;
+  }
+
   Fp2T Squeeze() {
     // Squeeze logic (simple)
     // Ensure permute if current block is used up (or just force permute for
@@ -224,10 +203,31 @@ public:
     if (Config::N_LIMBS == 1) {
       res.c0.val.limbs.data()[0] %= 19;
       res.c1.val.limbs.data()[0] %= 19;
+    } else {
+      // Real parameter sets: keep only the bits below the top bit of p, so
+      // both halves are < p without a modular reduction
+      mask_below_p(res.c0.val);
+      mask_below_p(res.c1.val);
     }
 
     return res;
   }
+
+private:
+  template <typename BigIntT> static void mask_below_p(BigIntT &v) {
+    const auto p = Config::p();
+    size_t top = Config::N_LIMBS - 1;
+    while (top > 0 && p.limbs[top] == 0)
+      --top;
+    uint64_t hi = p.limbs[top];
+    int bits = 0;
+    while (hi >> bits > 1)
+      ++bits;
+    // bits = index of the top set bit; keep the bits below it
+    for (size_t i = top + 1; i < Config::N_LIMBS; ++i)
+      v.limbs[i] = 0;
+    v.limbs[top] &= bits ? (~0ULL >> (64 - bits)) : 0;
+  }
 };
 
 } // namespace crypto
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "bivariate.hpp"
+#include "cross_terms.hpp"
+#include "relaxed_folding.hpp"
+#include "thread_pool.hpp"
+#include "transcript.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+
+// Binary-tree reduction of n fresh witnesses into one relaxed accumulator
+// The tree is fixed by n alone: level by level, nodes 2i and 2i + 1 fold into
+// node i of the next level and an odd last node is carried up unchanged.
+// Every node has its own Transcript:
+//
+//   leaf i:    absorb (i, w_i)                         -> digest
+//   internal:  absorb (digest_left, digest_right, T),
+//              squeeze r, fold, absorb acc_new         -> digest
+//
+// so a node's challenge depends only on its subtree, never on the order in
+// which threads finished, and the root is bit-identical for any pool size.
+// Folds use CrossTermEngine; both children are relaxed accumulators, and the
+// parent satisfies Phi(acc) = u whenever its left child does.
+//
+// Scheduling: the leaves are cut into aligned blocks of BLOCK (a power of
+// two) that are pool tasks, each folding its perfect subtree sequentially
+// with a height stack (O(log BLOCK) live nodes, leaves produced on demand).
+// The block roots are then reduced level by level, one parallel_for per
+// level. Merging a short last block right to left reproduces the carry rule,
+// so the block size changes the schedule but not the tree.
+template <typename Config> class TreeFolder {
+  using Fp2T = Fp2<Config>;
+  using Folder = RelaxedIsogenyFolder<Config>;
+  using Engine = CrossTermEngine<Config>;
+  using TranscriptT = Transcript<Config>;
+
+public:
+  using Witness = typename Folder::RelaxedWitness;
+  using Digest = typename TranscriptT::Digest;
+
+  static constexpr size_t DEFAULT_BLOCK = 1024;
+
+  struct Node {
+    Witness acc;
+    Digest digest{};
+  };
+
+  BivariatePoly<Fp2T> phi;
+  Engine engine;
+  ThreadPool *pool;
+  size_t block;
+
+  explicit TreeFolder(const BivariatePoly<Fp2T> &phi,
+                      ThreadPool *pool = nullptr,
+                      size_t block = DEFAULT_BLOCK)
+      : phi(phi), engine(phi), pool(pool), block(1) {
+    while (this->block < block)
+      this->block <<= 1;
+  }
+
+  // Folds leaf(0) .. leaf(n - 1). leaf(i) must be a pure function of i: it
+  // is called once per index, from any thread.
+  template <typename Leaf> Node fold(size_t n, Leaf &&leaf) const {
+    if (n == 0) {
+      std::cerr << "TreeFolder: nothing to fold" << std::endl;
+      return Node{Witness::zero(), Digest{}};
+    }
+
+    const size_t blocks = (n + block - 1) / block;
+    std::vector<Node> level(blocks);
+    for_each(blocks, [&](size_t b) {
+      level[b] = fold_range(b * block, std::min(n, (b + 1) * block), leaf);
+    });
+
+    while (level.size() > 1) {
+      std::vector<Node> up((level.size() + 1) / 2);
+      for_each(level.size() / 2, [&](size_t i) {
+        up[i] = merge(level[2 * i], level[2 * i + 1]);
+      });
+      if (level.size() % 2)
+        up.back() = level.back();
+      level = std::move(up);
+    }
+    return level[0];
+  }
+
+  Node fold(const std::vector<Witness> &leaves) const {
+    return fold(leaves.size(), [&](size_t i) { return leaves[i]; });
+  }
+
+  bool verify(const Node &root) const { return Folder::verify(phi, root.acc); }
+
+  // The two node rules, public so a verifier can replay any subtree
+  static Node make_leaf(uint64_t index, const Witness &w) {
+    TranscriptT t;
+    t.AbsorbBytes((const uint8_t *)&index, sizeof(index));
+    t.Absorb(w);
+    return Node{w, t.SqueezeDigest()};
+  }
+
+  Node merge(const Node &left, const Node &right) const {
+    TranscriptT t;
+    t.Absorb(left.digest);
+    t.Absorb(right.digest);
+    auto T = engine.cross_terms(left.acc, right.acc);
+    t.Absorb(T);
+    Fp2T r = t.Squeeze();
+    if (r.c0.val.limbs[0] == 0 && r.c1.val.limbs[0] == 0) {
+      r.c0.val.limbs[0] = 1;
+    }
+    Node parent;
+    parent.acc = Engine::fold(left.acc, right.acc, T, r);
+    t.Absorb(parent.acc);
+    parent.digest = t.SqueezeDigest();
+    return parent;
+  }
+
+private:
+  // Leaves [lo, hi) of one block: equal heights merge as soon as they meet,
+  // what is left merges right to left (the carry rule of a short level)
+  template <typename Leaf>
+  Node fold_range(size_t lo, size_t hi, Leaf &leaf) const {
+    std::vector<std::pair<Node, unsigned>> stack; // node, height
+    for (size_t i = lo; i < hi; ++i) {
+      Node n = make_leaf((uint64_t)i, leaf(i));
+      unsigned h = 0;
+      while (!stack.empty() && stack.back().second == h) {
+        n = merge(stack.back().first, n);
+        stack.pop_back();
+        ++h;
+      }
+      stack.emplace_back(std::move(n), h);
+    }
+    Node n = std::move(stack.back().first);
+    stack.pop_back();
+    while (!stack.empty()) {
+      n = merge(stack.back().first, n);
+      stack.pop_back();
+    }
+    return n;
+  }
+
+  template <typename Func> void for_each(size_t n, Func &&fn) const {
+    if (pool) {
+      pool->parallel_for(n, fn);
+      return;
+    }
+    for (size_t i = 0; i < n; ++i)
+      fn(i);
+  }
+};
+
+} // namespace crypto
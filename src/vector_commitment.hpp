@@ -0,0 +1,220 @@
+#pragma once
+
+#include "cache_io.hpp"
+#include "commitment_fast.hpp"
+#include "edwards_fast.hpp"
+#include "keccak.hpp"
+#include "msm.hpp"
+#include "thread_pool.hpp"
+#include "transcript.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace crypto {
+
+// Vector Pedersen commitment C = sum v_i G_i + [blind] H over the
+// PedersenCommitmentFast curve, computed as one Pippenger MSM of n + 1 terms
+//
+// Generators are derived, not chosen: G_i = HashToCurve(i) and
+// H = HashToCurve(BLIND_INDEX). HashToCurve squeezes y from a Transcript over
+// (DOMAIN, index, counter), solves a x^2 + y^2 = 1 + d x^2 y^2 for x and
+// retries with the next counter until x exists; the point is then multiplied
+// by 4 (every twisted Edwards group order is a multiple of 4) and
+// normalised. Nobody knows a relation between them, and the set only grows:
+// G_0 .. G_{n-1} are the same for every n.
+//
+// Deriving a generator costs an inversion and a square root, so the set is
+// generated in parallel (ThreadPool), normalised with one shared inversion
+// (NormalizeBatch) and kept on disk (CacheIO::KIND_PEDERSEN_GENERATORS,
+// affine x and y). A cached set shorter than n is extended and written back.
+template <typename Config> class VectorPedersenCommitment {
+  using Fp2T = Fp2<Config>;
+  using TranscriptT = Transcript<Config>;
+
+public:
+  using Curve = TwistedEdwardsFast<Config>;
+  using Point = typename Curve::Point;
+  using Scalar = BigInt<Config::N_LIMBS>;
+  using MSM = PippengerMSM<Config>;
+
+  static constexpr uint32_t CACHE_VERSION = 1;
+  static constexpr const char *DOMAIN = "QHALO-VectorPedersen-v1";
+  static constexpr uint64_t BLIND_INDEX = ~0ULL;
+
+private:
+  Curve curve;
+  ThreadPool *pool;
+  std::vector<Point> G;
+  Point H;
+
+public:
+  // n generators; pool (optional) for generation and the MSMs
+  explicit VectorPedersenCommitment(size_t n, ThreadPool *pool = nullptr,
+                                    bool use_cache = true)
+      : curve(PedersenCommitmentFast<Config>::DefaultCurve()), pool(pool) {
+    H = HashToCurve(curve, BLIND_INDEX);
+    if (use_cache)
+      load_or_generate(n);
+    else
+      G = generate(curve, 0, n, pool);
+  }
+
+  size_t size() const { return G.size(); }
+  const std::vector<Point> &generators() const { return G; }
+  const Point &blinding_generator() const { return H; }
+  const Curve &GetCurve() const { return curve; }
+
+  // C = sum values[i] G_i + [blind] H; values may be shorter than size()
+  Point Commit(const std::vector<Scalar> &values, const Scalar &blind) const {
+    if (values.size() > G.size()) {
+      std::cerr << "VectorPedersenCommitment: " << values.size()
+                << " values for " << G.size() << " generators" << std::endl;
+      return Point::identity();
+    }
+    std::vector<Point> bases(G.begin(), G.begin() + values.size());
+    bases.push_back(H);
+    std::vector<Scalar> scalars = values;
+    scalars.push_back(blind);
+    return MSM::Mul(curve, bases, scalars, pool);
+  }
+
+  // 64-bit values: the MSM sizes its windows to the 64-bit scalars
+  Point Commit(const std::vector<uint64_t> &values, uint64_t blind) const {
+    std::vector<Scalar> scalars(values.begin(), values.end());
+    return Commit(scalars, Scalar(blind));
+  }
+
+  Point AddCommitments(const Point &C1, const Point &C2) const {
+    return curve.Add(C1, C2);
+  }
+
+  static bool PointsEqual(const Point &P, const Point &Q) {
+    return Curve::PointsEqual(P, Q);
+  }
+
+  // Deterministic point for an index, affine (Z = 1)
+  static Point HashToCurve(const Curve &curve, uint64_t index) {
+    Point P = hash_projective(curve, index);
+    Curve::Normalize(P);
+    return P;
+  }
+
+private:
+  // HashToCurve before the normalisation
+  static Point hash_projective(const Curve &curve, uint64_t index) {
+    for (uint64_t ctr = 0;; ++ctr) {
+      TranscriptT t;
+      t.AbsorbBytes((const uint8_t *)DOMAIN, strlen(DOMAIN));
+      t.AbsorbBytes((const uint8_t *)&index, sizeof(index));
+      t.AbsorbBytes((const uint8_t *)&ctr, sizeof(ctr));
+      // below p, so already a valid Montgomery representation
+      Fp2T y = t.Squeeze();
+
+      // x^2 = (1 - y^2) / (a - d y^2)
+      Fp2T y2 = Fp2T::sqr(y);
+      Fp2T den = Fp2T::sub(curve.a, Fp2T::mul(curve.d, y2));
+      if (den.is_zero())
+        continue;
+      Fp2T x2 = Fp2T::mul(Fp2T::sub(Fp2T::one(), y2), Fp2T::inv(den));
+      if (x2.is_zero())
+        continue;
+      Fp2T x = Fp2T::sqrt(x2);
+      if (!Fp2T::equal(Fp2T::sqr(x), x2))
+        continue;
+
+      Point P = curve.Double(curve.Double(Point::from_affine(x, y)));
+      if (!P.is_identity())
+        return P;
+    }
+  }
+
+  // Generators [from, to), normalised together with one shared inversion
+  static std::vector<Point> generate(const Curve &curve, size_t from,
+                                     size_t to, ThreadPool *pool) {
+    std::vector<Point> out(to > from ? to - from : 0);
+    auto one = [&](size_t i) { out[i] = hash_projective(curve, from + i); };
+    if (pool)
+      pool->parallel_for(out.size(), one);
+    else
+      for (size_t i = 0; i < out.size(); ++i)
+        one(i);
+    Curve::NormalizeBatch(out);
+    return out;
+  }
+
+  void load_or_generate(size_t n) {
+    std::vector<uint8_t> key = cache_key();
+    uint8_t digest[32];
+    sha3_256(key.data(), key.size(), digest);
+    std::string path =
+        CacheIO::path_for("pedersen_gens_" + CacheIO::hex(digest, 8) + ".bin");
+
+    std::vector<uint8_t> payload;
+    if (CacheIO::read_validated(path, CacheIO::KIND_PEDERSEN_GENERATORS,
+                                CACHE_VERSION, payload))
+      deserialize(payload, key, n, G);
+    if (G.size() >= n) {
+      G.resize(n);
+      return;
+    }
+
+    std::vector<Point> more = generate(curve, G.size(), n, pool);
+    G.insert(G.end(), more.begin(), more.end());
+    if (!CacheIO::write_atomic(path, CacheIO::KIND_PEDERSEN_GENERATORS,
+                               CACHE_VERSION, serialize(key, G)))
+      std::cerr << "VectorPedersenCommitment: could not write " << path
+                << std::endl;
+  }
+
+  // (p, a, d, DOMAIN): stored in the payload too, so a file name collision
+  // can never hand back generators of another curve
+  std::vector<uint8_t> cache_key() const {
+    std::vector<uint8_t> key;
+    CacheIO::put(key, Config::p().limbs);
+    CacheIO::put_fp2(key, curve.a);
+    CacheIO::put_fp2(key, curve.d);
+    key.insert(key.end(), DOMAIN, DOMAIN + strlen(DOMAIN));
+    return key;
+  }
+
+  static std::vector<uint8_t> serialize(const std::vector<uint8_t> &key,
+                                        const std::vector<Point> &gens) {
+    std::vector<uint8_t> buf = key;
+    CacheIO::put(buf, (uint64_t)gens.size());
+    for (const Point &P : gens) {
+      CacheIO::put_fp2(buf, P.X);
+      CacheIO::put_fp2(buf, P.Y);
+    }
+    return buf;
+  }
+
+  // Reads at most `want` generators; leaves out empty on a bad payload
+  static void deserialize(const std::vector<uint8_t> &buf,
+                          const std::vector<uint8_t> &key, size_t want,
+                          std::vector<Point> &out) {
+    out.clear();
+    if (buf.size() < key.size() ||
+        memcmp(buf.data(), key.data(), key.size()) != 0)
+      return;
+    size_t off = key.size();
+    uint64_t count;
+    if (!CacheIO::get(buf, off, count) ||
+        count != (buf.size() - off) / (4 * sizeof(Scalar)) ||
+        (buf.size() - off) % (4 * sizeof(Scalar)) != 0)
+      return;
+    size_t take = (size_t)std::min<uint64_t>(count, want);
+    out.resize(take);
+    for (size_t i = 0; i < take; ++i) {
+      Fp2T x, y;
+      CacheIO::get_fp2(buf, off, x);
+      CacheIO::get_fp2(buf, off, y);
+      out[i] = Point::from_affine(x, y);
+    }
+  }
+};
+
+} // namespace crypto